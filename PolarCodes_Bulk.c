@@ -0,0 +1,212 @@
+#include "PolarCodes_Bulk.h"
+#include <stdlib.h>
+#include <pthread.h>
+
+/// @brief Jobs of a worker: range of job indices. The owner takes jobs from the front, other workers steal from the back.
+typedef struct
+{
+	pthread_mutex_t Lock;
+	uint32_t Begin;
+	uint32_t End;
+} JobQueue;
+
+typedef struct BulkState BulkState;
+
+typedef struct
+{
+	PLC_Context* Context;	// own clone -> own workspace
+	JobQueue Queue;
+	BulkState* State;
+	uint16_t Index;
+	pthread_t Thread;
+	bool Started;
+} BulkWorker;
+
+struct BulkState
+{
+	PLC_ReproduceJob const* Jobs;			// reproduction jobs, or ...
+	PLC_ReproduceResult* Results;
+	PLC_EnrollJob const* EnrollJobs;		// ... enrollment jobs
+	bool* EnrollResults;
+	BulkWorker* Workers;
+	uint16_t NumberOfWorkers;
+};
+
+// --- QUEUES --- //
+
+/// @brief Takes the next job from the front of the worker's own queue.
+/// @return True on success, false if the queue is empty.
+static bool PopJob(JobQueue *const Queue, uint32_t *const Job)
+{
+	pthread_mutex_lock(&Queue->Lock);
+	bool const Available = Queue->Begin < Queue->End;
+	if(Available) *Job = Queue->Begin++;
+	pthread_mutex_unlock(&Queue->Lock);
+
+	return Available;
+}
+
+/// @brief Steals half of the remaining jobs (rounded up) from the back of another worker's queue.
+/// The first stolen job is returned, the others are put into the thief's (empty) queue.
+/// @return True on success, false if all other queues are empty (-> no work left).
+static bool StealJobs(BulkState *const State, BulkWorker *const Thief, uint32_t *const Job)
+{
+	for(uint16_t i = 1; i < State->NumberOfWorkers; i++)
+	{
+		JobQueue *const Victim = &State->Workers[(Thief->Index + i) % State->NumberOfWorkers].Queue;
+
+		pthread_mutex_lock(&Victim->Lock);
+		uint32_t const Remaining = Victim->End - Victim->Begin;
+		uint32_t const End = Victim->End;
+		Victim->End -= (Remaining + 1) / 2;
+		uint32_t const Begin = Victim->End;
+		pthread_mutex_unlock(&Victim->Lock);
+
+		if(Remaining == 0) continue;
+
+		*Job = Begin;
+		pthread_mutex_lock(&Thief->Queue.Lock);
+		Thief->Queue.Begin = Begin + 1;
+		Thief->Queue.End = End;
+		pthread_mutex_unlock(&Thief->Queue.Lock);
+		return true;
+	}
+
+	return false;
+}
+
+// --- WORKERS --- //
+
+static void* RunWorker(void* Argument)
+{
+	BulkWorker *const Worker = Argument;
+	BulkState *const State = Worker->State;
+
+	uint32_t Index;
+	while(PopJob(&Worker->Queue, &Index) || StealJobs(State, Worker, &Index))
+	{
+		if(State->EnrollJobs != 0)
+		{
+			PLC_EnrollJob const*const Job = &State->EnrollJobs[Index];
+			State->EnrollResults[Index] = PLC_Enroll(Worker->Context, Job->Fingerprint, Job->FingerprintLength, Job->FrozenBitMask, Job->FrozenBitMaskLength,
+													 Job->HelperData, Job->HelperDataSize, Job->ValidationHash, Job->ValidationHashLength, Job->Key, Job->KeyLength);
+			continue;
+		}
+
+		PLC_ReproduceJob const*const Job = &State->Jobs[Index];
+
+		uint8_t* Key = PLC_Reproduce_Ctx(Worker->Context, Job->Fingerprint, Job->FingerprintLength, Job->HelperData, Job->HelperDataSize,
+										 Job->FrozenBitMask, Job->FrozenBitMaskLength, Job->ValidationHash, Job->ValidationHashLength);
+		State->Results[Index].Key = Key;
+		State->Results[Index].Success = Key != 0;
+	}
+
+	return 0;
+}
+
+/// @brief Deletes the workers (contexts, queue locks) and the worker array.
+static void DeleteWorkers(BulkWorker* Workers, uint16_t const NumberOfWorkers)
+{
+	if(Workers == 0) return;
+
+	for(uint16_t i = 0; i < NumberOfWorkers; i++)
+	{
+		PLC_DeleteContext(Workers[i].Context);
+		pthread_mutex_destroy(&Workers[i].Queue.Lock);
+	}
+	free(Workers);
+}
+
+/// @brief Creates the workers, each with a clone of the given context and an even share of the jobs.
+/// @return Worker array, nullptr on error.
+static BulkWorker* CreateWorkers(PLC_Context const*const Context, BulkState *const State, uint32_t const NumberOfJobs)
+{
+	uint16_t const NumberOfWorkers = State->NumberOfWorkers;
+
+	BulkWorker* Workers = calloc(NumberOfWorkers, sizeof(BulkWorker));
+	if(Workers == 0) return 0;
+
+	for(uint16_t i = 0; i < NumberOfWorkers; i++)
+	{
+		if(pthread_mutex_init(&Workers[i].Queue.Lock, 0) != 0)
+		{
+			DeleteWorkers(Workers, i);
+			return 0;
+		}
+
+		Workers[i].Context = PLC_CloneContext(Context);
+		Workers[i].Queue.Begin = (uint32_t)((uint64_t)NumberOfJobs * i / NumberOfWorkers);
+		Workers[i].Queue.End = (uint32_t)((uint64_t)NumberOfJobs * (i + 1) / NumberOfWorkers);
+		Workers[i].State = State;
+		Workers[i].Index = i;
+
+		if(Workers[i].Context == 0)
+		{
+			DeleteWorkers(Workers, i + 1);
+			return 0;
+		}
+	}
+
+	return Workers;
+}
+
+/// @brief Runs all jobs of the state on its workers: worker 0 on the calling thread, the others on their own threads.
+/// @return True if all jobs were processed, false on error (out of memory).
+static bool RunWorkers(PLC_Context const*const Context, BulkState *const State, uint32_t const NumberOfJobs, uint16_t const NumberOfThreads)
+{
+	State->NumberOfWorkers = NumberOfThreads == 0 ? 1 : NumberOfThreads;
+	if(State->NumberOfWorkers > NumberOfJobs) State->NumberOfWorkers = (uint16_t)NumberOfJobs;
+
+	State->Workers = CreateWorkers(Context, State, NumberOfJobs);
+	if(State->Workers == 0) return false;
+
+	//jobs of workers failing to start are stolen by the others
+	for(uint16_t i = 1; i < State->NumberOfWorkers; i++)
+	{
+		State->Workers[i].Started = pthread_create(&State->Workers[i].Thread, 0, RunWorker, &State->Workers[i]) == 0;
+	}
+	RunWorker(&State->Workers[0]);
+
+	for(uint16_t i = 1; i < State->NumberOfWorkers; i++)
+	{
+		if(State->Workers[i].Started) pthread_join(State->Workers[i].Thread, 0);
+	}
+
+	DeleteWorkers(State->Workers, State->NumberOfWorkers);
+	return true;
+}
+
+// --- BULK REPRODUCE --- //
+
+bool PLC_Reproduce_Bulk(PLC_Context const *const Context, PLC_ReproduceJob const *const Jobs, uint32_t const NumberOfJobs,
+						PLC_ReproduceResult *const Results, uint16_t const NumberOfThreads)
+{
+	if((Jobs == 0 || Results == 0) && NumberOfJobs > 0) return false;
+
+	for(uint32_t i = 0; i < NumberOfJobs; i++)
+	{
+		Results[i].Key = 0;
+		Results[i].Success = false;
+	}
+	if(NumberOfJobs == 0) return true;
+
+	BulkState State = { Jobs, Results, 0, 0, 0, 0 };
+	return RunWorkers(Context, &State, NumberOfJobs, NumberOfThreads);
+}
+
+// --- BULK ENROLL --- //
+
+bool PLC_Enroll_Bulk(PLC_Context const *const Context, PLC_EnrollJob const *const Jobs, uint32_t const NumberOfJobs,
+					 bool *const Results, uint16_t const NumberOfThreads)
+{
+	if((Jobs == 0 || Results == 0) && NumberOfJobs > 0) return false;
+
+	for(uint32_t i = 0; i < NumberOfJobs; i++)
+	{
+		Results[i] = false;
+	}
+	if(NumberOfJobs == 0) return true;
+
+	BulkState State = { 0, 0, Jobs, Results, 0, 0 };
+	return RunWorkers(Context, &State, NumberOfJobs, NumberOfThreads);
+}
@@ -0,0 +1,68 @@
+#ifndef PLC_BULK_H
+#define PLC_BULK_H
+#include <stdint.h>
+#include <stdbool.h>
+#include "PolarCodes_HASCL.h"
+
+/*  Bulk reproduction / enrollment: many PLC_Reproduce / PLC_Enroll jobs spread over worker threads (e.g. a backend verifying a fleet of devices, a production line enrolling a wafer).
+*   Every worker owns a clone of the given context (-> its own workspace and plan cache), nothing is shared while decoding.
+*   Jobs are distributed via per-worker queues, idle workers steal half of the remaining jobs of another worker.
+*   Uses POSIX threads (link with -pthread), compile PolarCodes_Bulk.c alongside PolarCodes_HASCL.c.
+*/
+
+/// @brief Single reproduction job, parameters as for PLC_Reproduce.
+typedef struct
+{
+	uint8_t const* Fingerprint;
+	uint32_t FingerprintLength;
+	uint8_t const* HelperData;
+	uint32_t HelperDataSize;
+	uint8_t const* FrozenBitMask;
+	uint32_t FrozenBitMaskLength;
+	uint8_t const* ValidationHash;
+	uint16_t ValidationHashLength;
+} PLC_ReproduceJob;
+
+/// @brief Result of a reproduction job.
+typedef struct
+{
+	uint8_t* Key;	// reproduced key, with length PLC_GetKeyLength (free it yourself!), nullptr on failure
+	bool Success;
+} PLC_ReproduceResult;
+
+/// @brief Reproduces the keys of all jobs, using the given number of threads (the calling thread is one of them).
+/// @param Context Configuration (code parameters, node specializations, CRC) used for all jobs, nullptr -> default context (PLC_Init). It is not modified.
+/// @param Jobs Array of jobs.
+/// @param NumberOfJobs Number of jobs.
+/// @param Results Output, one result per job (same order as the jobs).
+/// @param NumberOfThreads Number of worker threads, 0 -> 1.
+/// @return True if all jobs were processed (see the results for the outcome of each job), false on error (invalid parameters, out of memory).
+bool PLC_Reproduce_Bulk(PLC_Context const*const Context, PLC_ReproduceJob const*const Jobs, uint32_t const NumberOfJobs,
+                        PLC_ReproduceResult *const Results, uint16_t const NumberOfThreads);
+
+/// @brief Single enrollment job, parameters as for PLC_Enroll (outputs are written into the given buffers).
+typedef struct
+{
+	uint8_t const* Fingerprint;
+	uint32_t FingerprintLength;
+	uint8_t const* FrozenBitMask;
+	uint32_t FrozenBitMaskLength;
+	uint8_t* HelperData;		// output, at least PLC_GetHelperDataSize bytes
+	uint32_t HelperDataSize;
+	uint8_t* ValidationHash;	// output
+	uint16_t ValidationHashLength;
+	uint8_t* Key;				// output, at least PLC_GetKeyLength bytes
+	uint16_t KeyLength;
+} PLC_EnrollJob;
+
+/// @brief Enrolls all jobs, using the given number of threads (the calling thread is one of them).
+/// @param Context Configuration (code parameters, CRC, systematic mode) used for all jobs, nullptr -> default context (PLC_Init). It is not modified.
+/// @param Jobs Array of jobs.
+/// @param NumberOfJobs Number of jobs.
+/// @param Results Output, success of every job (same order as the jobs).
+/// @param NumberOfThreads Number of worker threads, 0 -> 1.
+/// @return True if all jobs were processed (see the results for the outcome of each job), false on error (invalid parameters, out of memory).
+bool PLC_Enroll_Bulk(PLC_Context const*const Context, PLC_EnrollJob const*const Jobs, uint32_t const NumberOfJobs,
+                     bool *const Results, uint16_t const NumberOfThreads);
+
+#endif
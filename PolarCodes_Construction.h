@@ -0,0 +1,35 @@
+#ifndef PLC_CONSTRUCTION_H
+#define PLC_CONSTRUCTION_H
+#include <stdint.h>
+#include <stdbool.h>
+
+/*  Construction of frozen bit masks: the K most reliable bit channels carry information, all others are frozen.
+*   The bit channel index is the plain text bit index (x = u * F^(xn), no bit reversal), as in 3GPP TS 38.212.
+*   Output format as used by the decoder: frozen bits are 0, non-frozen bits are 1.
+*/
+
+/// @brief Construction methods.
+typedef enum
+{
+	PLC_Construction_5GNR,			// reliability sequence of 3GPP TS 38.212 (table 5.3.1.2-1), channel independent, N <= 1024
+	PLC_Construction_Bhattacharyya,	// Bhattacharyya parameters Z = 2 sqrt(p (1 - p)), exact for the erasure channel, an upper bound otherwise
+	PLC_Construction_GA				// Gaussian approximation: mean LLRs of the bit channels, starting from the mean LLR of the BSC
+} PLC_ConstructionMethod;
+
+/// @brief Creates a frozen bit mask for the given code parameters and channel.
+/// @param N Word length (in bits). Has to be a power of 2 (>= 8).
+/// @param K Number of information bits.
+/// @param Method Construction method.
+/// @param CrossoverProbability Bit flip probability of the fingerprint / channel (0 < p < 0.5), not used by PLC_Construction_5GNR.
+/// @param FrozenBitMask Output.
+/// @param FrozenBitMaskLength Mask length (in bytes), has to be N / 8.
+/// @return True on success, false on invalid parameters.
+bool PLC_CreateFrozenBitMask(uint32_t const N, uint32_t const K, PLC_ConstructionMethod const Method, double const CrossoverProbability,
+                             uint8_t *const FrozenBitMask, uint32_t const FrozenBitMaskLength);
+
+/// @brief Sorts the bit channel indices by reliability (the mask consists of the last K of them).
+/// @param Order Output: N bit channel indices, least reliable first.
+/// @return True on success, false on invalid parameters.
+bool PLC_GetReliabilityOrder(uint32_t const N, PLC_ConstructionMethod const Method, double const CrossoverProbability, uint32_t *const Order);
+
+#endif
@@ -1,684 +1,2725 @@
-//ignores crypto lib to be able to run example
-//#define IgnoreTomCrypt
-
 #include "PolarCodes_HASCL.h"
 #include "BitHelperFunctions.h"
+#include "PolarCodes_Kernels.h"
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
-#ifndef IgnoreTomCrypt
-	#include <tomcrypt.h>
+#ifdef PLC_ENABLE_STATS
+	#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+		#include <x86intrin.h>
+	#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+		#include <intrin.h>
+	#else
+		#include <time.h>
+	#endif
+#endif
+
+//Node types (-> Fast-SSC node specialization)
+typedef uint8_t NodeType;
+#define NT_Generic 0	// decoded by traversing its children
+#define NT_Rate0 1		// all leaves frozen
+#define NT_Rate1 2		// no leaf frozen
+#define NT_REP 3		// all leaves frozen, except the last one (repetition code)
+#define NT_SPC 4		// no leaf frozen, except the first one (single parity check code)
+
+//Plan operations
+#define PO_F 0			// left child LLRs
+#define PO_G 1			// right child LLRs
+#define PO_Combine 2	// node decisions from the children's decisions
+#define PO_FrozenLeaf 3
+#define PO_InfoLeaf 4
+#define PO_FastNode 5	// specialized node, decoded in closed form
+
+#define SelectionNetworkMaxLength 64 // path selection: sorting network up to this number of candidates (padded to a power of 2), quickselect above
+
+//Path metric: sum of the LLR magnitudes contradicting a path's decisions. Wider than the LLRs, saturating, and normalized to the list minimum after every fork (-> no overflow for long codes)
+typedef PLC_PathMetric PathMetric_t;
+#ifndef PLC_LLR_FLOAT
+	#define PathMetric_Max INT32_MAX
 #endif
 
-static uint16_t N = 1024;
-#define NBytes (N/8)
-#define n ((uint16_t)log2(N))
-static uint16_t K = 128;
-#define KBytes (K/8)
-static uint8_t NumberOfDecoders = 2;
+typedef struct
+{
+	BPSK_t** LLRs;			// per depth: row of the layer this decoder currently references
+	Decision_t** Decisions;	// per depth: row of the layer this decoder currently references
+	uint8_t* Layers;		// per depth: layer slot this decoder currently references (layers are shared between decoders, copy on write)
+	PathMetric_t PathMetrics;
+	uint16_t CRC;			// CRC register over the information bits since the last CRC checkpoint
+	uint32_t* NodeBits;		// Fast-SSC: least reliable bit positions of the Rate-1 / SPC node currently processed
+	BPSK_t* NodeLLRs;		// Fast-SSC: LLRs at these positions (-> the LLR row is not copied when the layer is copied on write)
+	uint8_t Parity;			// Fast-SSC: parity of the SPC node currently processed
+} DecoderData;
+
+typedef struct {
+	uint8_t DecoderId;
+	PathMetric_t PathMetric;
+	Decision_t Decision;
+	uint32_t Index;			// bit index of the decision (within the decision row)
+} DecoderDecision;
+
+/// @brief Scratch memory for decoding, sized once from N and the list size (-> decoding itself does not allocate).
+typedef struct
+{
+	DecoderData* Pool;				// NumberOfDecoders decoders, their rows point into LLRBlock / DecisionBlock
+	BPSK_t** LLRRows;				// NumberOfDecoders * (n + 1) row pointers
+	Decision_t** DecisionRows;		// NumberOfDecoders * (n + 1) row pointers
+	uint8_t* DecoderLayers;			// NumberOfDecoders * (n + 1) layer slots
+	DecoderData** FreeDecoders;		// stack of unused pool entries
+	uint8_t NumberFreeDecoders;
+
+	//layers: per depth NumberOfDecoders slots, each holding a LLR row and a decision row, shared by reference counting
+	//rows are compact: depth d holds the N >> d LLRs of the node currently processed (-> 2N - 1 LLRs per slot over all depths)
+	//and the decisions of both children of the node currently processed at depth d - 1 (depth 0: root node, depth n: plain text)
+	BPSK_t* LLRBlock;				// NumberOfDecoders * (2N - 1) LLRs, depth by depth
+	Decision_t* DecisionBlock;		// NumberOfDecoders * GetDecisionRowBytes() per depth, depth by depth (bit packed)
+	uint32_t* DecisionRowOffsets;	// n + 1 start offsets of the depths in DecisionBlock
+	uint8_t* LayerReferences;		// (n + 1) * NumberOfDecoders reference counters
+	uint8_t* FreeLayers;			// per depth: stack of unused layer slots
+	uint8_t* NumberFreeLayers;		// per depth: number of unused layer slots
+
+	BPSK_t* ChannelLLRs;			// N LLRs, decoder input
+	DecoderData** Decoders;			// active decoders (list)
+	NodeType* NodeTypes;			// 2N - 1 node types (heap order: node j at depth d -> 2^d + j - 1)
+	uint32_t* NodeBitsBlock;		// NumberOfDecoders * NumberOfDecoders least reliable bit positions
+	BPSK_t* NodeLLRsBlock;			// NumberOfDecoders * NumberOfDecoders LLRs of the least reliable bits
+	DecoderDecision* DecoderDecisions; // 2 * NumberOfDecoders decision candidates
+	uint64_t* SelectionKeys;		// max(2 * NumberOfDecoders, SelectionNetworkMaxLength) keys of the path selection
+	uint64_t* SelectionCopies;		// NumberOfDecoders keys of the candidates taken by copies
+	uint8_t* Scratch;				// 2 * NBytes bytes, reproduction: code word, raw key
+	uint8_t const** Candidates;		// NumberOfDecoders plain texts hashed at once (multi-buffer)
+	uint8_t* Digests;				// NumberOfDecoders * PLC_MaxDigestLength bytes, their digests
+	uint16_t CRCValues[UINT8_MAX];	// expected CRC value for every checkpoint (enrollment: computed, reproduction: read from the helper data)
+} PLC_Workspace;
+
+/// @brief Single step of a decoding plan. Offset is the start index of the node within its depth's rows
+/// (equal to the start index of its left child within the child depth's rows), Length is the number of outgoing beliefs (leaves: 1, fast nodes: node size).
+typedef struct
+{
+	uint8_t Operation;	// PO_...
+	uint8_t Depth;
+	NodeType Type;		// PO_FastNode: node type
+	uint32_t Length;
+	uint32_t Offset;
+} PlanInstruction;
+
+/// @brief Decoding schedule for a frozen bit mask: flat instruction list of the tree traversal, compiled once and executed by SCL_Decode.
+struct PLC_Plan
+{
+	uint8_t* FrozenBitMask;			// NBytes, key of the plan
+	uint8_t FastNodes;				// node specializations the plan was compiled with, key of the plan
+	bool CodeWord;					// combines of the rightmost path included (-> code word estimate in the depth 0 row), plans with it serve decoding without too
+	PlanInstruction* Instructions;
+	uint32_t NumberOfInstructions;
+};
 
-#define BPSK_t int16_t
-#define Decision_t uint8_t
+#define PlanCacheSize 4 // plans cached per context (-> masks in use at once)
 
-#define SHA1_ByteLength 20
-static uint8_t* SHA1_Hash(uint8_t const*const Values, uint16_t const ByteLength)
+/// @brief CRC aided decoding: a CRC over the information bits is checked at every checkpoint, paths failing the check are dropped.
+typedef struct
 {
-	int idx, err;
+	uint8_t Length;				// CRC length (in bits), 0 -> CRC disabled
+	uint16_t Polynomial;		// generator polynomial, without the leading x^Length term
+	uint32_t* Checkpoints;		// information bit indices (ascending), after which a CRC is checked
+	uint8_t NumberOfCheckpoints;
+} PLC_CRCConfig;
 
-	#ifndef IgnoreTomCrypt
-		if (register_hash(&sha1_desc) == -1) return 0;
-		idx = find_hash("sha1");
+struct PLC_Context
+{
+	uint32_t N;
+	uint16_t n; // log2(N)
+	uint32_t NBytes;
+	uint32_t K;
+	uint32_t KBytes;
+	uint8_t NumberOfDecoders;
+	uint8_t FastNodes; // enabled node specializations (PLC_FastNode_...)
+	PLC_Kernels const* Kernels; // f / g / combine kernels, selected at runtime
+	PLC_CRCConfig CRC;
+	PLC_Workspace* Workspace;
+	PLC_Plan* Plans[PlanCacheSize]; // cached by frozen bit mask
+	uint8_t NextPlan; // cache slot replaced next
+	uint8_t MaxListSize; // adaptive list size: largest list tried during reproduction, 0 -> always NumberOfDecoders
+	uint8_t EffectiveListSize; // list size of the pass which reproduced the last key, 0 -> failed
+	bool Systematic; // systematic code: information bits at the non-frozen positions of the code word (enrollment, reproduction, PLC_SCL_Decode_InfoBits)
+	bool CodeWordOutput; // list decoders return the code word estimates of the paths instead of their plain texts
+	PLC_HashProvider const* Hash; // validation hash and key derivation, registered once (PLC_SetHashProvider)
+	#ifdef PLC_ENABLE_STATS
+		PLC_Stats Stats;
 	#endif
+};
 
-	uint8_t* Hash = malloc(SHA1_ByteLength);
-	uint16_t OutLen = SHA1_ByteLength;
+// --- STATISTICS --- //
 
-	#ifndef IgnoreTomCrypt
-		if ((err = hash_memory(idx, Values, ByteLength, Hash, &OutLen)) != CRYPT_OK || OutLen != SHA1_ByteLength) {
-			free(Hash);
-			return 0;
-		}
+#ifdef PLC_ENABLE_STATS
+/// @brief Timestamp for the stage timers: TSC cycles on x86, nanoseconds elsewhere.
+static uint64_t ReadTimer()
+{
+	#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) || defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+		return __rdtsc();
+	#else
+		struct timespec Time;
+		clock_gettime(CLOCK_MONOTONIC, &Time);
+		return (uint64_t)Time.tv_sec * 1000000000u + Time.tv_nsec;
 	#endif
+}
 
-	return Hash;
+/// @brief Adds the time since the last lap to a stage and starts the next lap.
+static void LapTimer(PLC_Context const*const Context, PLC_Stage const Stage, uint64_t *const Lap)
+{
+	uint64_t const Now = ReadTimer();
+	((PLC_Context*)Context)->Stats.Time[Stage] += Now - *Lap;
+	*Lap = Now;
 }
 
-// --- INIT --- //
-void PLC_Init(uint16_t const N_, uint16_t const K_, uint8_t const _NumberOfDecoders)
+	//statistics are bookkeeping, not configuration -> also collected for const contexts
+	#define STATS_ADD(Context, Counter, Value) (((PLC_Context*)(Context))->Stats.Counter += (Value))
+	#define STATS_START(Lap) uint64_t Lap = ReadTimer()
+	#define STATS_LAP(Context, Stage, Lap) LapTimer(Context, Stage, &Lap)
+#else
+	#define STATS_ADD(Context, Counter, Value) ((void)0)
+	#define STATS_START(Lap) ((void)0)
+	#define STATS_LAP(Context, Stage, Lap) ((void)0)
+#endif
+
+/// @brief Context used by the legacy (context-free) API, configured via PLC_Init.
+static PLC_Context DefaultContext = { .N = 1024, .n = 10, .NBytes = 128, .K = 128, .KBytes = 16, .NumberOfDecoders = 2 }; // other fields zero (-> set up lazily)
+
+/// @brief Hash of the given values, by the context's hash provider.
+/// @param Digest Output, Context->Hash->DigestLength bytes.
+/// @return True on success.
+static bool HashValues(PLC_Context const*const Context, uint8_t const*const Values, uint32_t const ByteLength, uint8_t *const Digest)
 {
-	N = N_;
-	K = K_;
-	NumberOfDecoders = _NumberOfDecoders;
+	PLC_HashProvider const*const Hash = Context->Hash;
+	return Hash->Hash(Hash->UserData, Values, ByteLength, Digest);
 }
 
-// --- REPRODUCE --- //
-uint8_t *PLC_Reproduce(
-	uint8_t const *const Fingerprint, uint16_t const FingerprintLength,
-	uint8_t const *const HelperData, uint16_t const HelperDataSize,
-	uint8_t const *const FrozenBitMask, uint16_t const FrozenBitMaskLength,
-	uint8_t const *const ValidationHash, uint16_t const ValidationHashLength)
+// --- INIT --- //
+
+/// @brief Fills the code parameters and everything derived from them.
+/// @return True on success, false if the parameters are invalid.
+static bool SetupContext(PLC_Context *const Context, uint32_t const N, uint32_t const K, uint8_t const NumberOfDecoders)
 {
-	#ifdef IgnoreTomCrypt
-		return 0; //no crypto lib -> hash aid to decide on decoder output wont work!
-	#endif
-	if(Fingerprint == 0 || FingerprintLength < NBytes) return 0;
-	if(HelperData == 0 || HelperDataSize == 0) return 0;
-	if(FrozenBitMask == 0 || FrozenBitMaskLength != NBytes) return 0;
-	if(ValidationHash == 0 || ValidationHashLength != SHA1_ByteLength) return 0;
+	if(Context == 0) return false;
+	if(N < 8 || N > PLC_MaxBlockLength || (N & (N - 1)) != 0) return false; // N has to be a power of 2 (and at least one byte)
+	if(K == 0 || K > N || NumberOfDecoders == 0) return false;
+
+	uint16_t Log2N = 0;
+	while((1u << Log2N) < N) Log2N++;
+
+	Context->N = N;
+	Context->n = Log2N;
+	Context->NBytes = N / 8;
+	Context->K = K;
+	Context->KBytes = K / 8;
+	Context->NumberOfDecoders = NumberOfDecoders;
+	Context->Kernels = PLC_GetKernels(PLC_KernelLevel_Best);
+	if(Context->Hash == 0) Context->Hash = PLC_GetHashProvider(PLC_Hash_SHA1, true); // kept on re-init (PLC_Init)
+	return true;
+}
 
-	//apply frozen bit mask
-	uint8_t* MaskedFingerprint = malloc(NBytes);
-	for(uint16_t i = 0; i < NBytes; i++)
-	{
-		MaskedFingerprint[i] = Fingerprint[i] & FrozenBitMask[i];
-	}
+/// @brief Deletes a workspace -> frees memory.
+static void DeleteWorkspace(PLC_Workspace* Workspace)
+{
+	if(Workspace == 0) return;
+
+	free(Workspace->Pool);
+	free(Workspace->LLRBlock);
+	free(Workspace->DecisionBlock);
+	free(Workspace->DecisionRowOffsets);
+	free(Workspace->LLRRows);
+	free(Workspace->DecisionRows);
+	free(Workspace->DecoderLayers);
+	free(Workspace->FreeDecoders);
+	free(Workspace->LayerReferences);
+	free(Workspace->FreeLayers);
+	free(Workspace->NumberFreeLayers);
+	free(Workspace->ChannelLLRs);
+	free(Workspace->Decoders);
+	free(Workspace->NodeTypes);
+	free(Workspace->NodeBitsBlock);
+	free(Workspace->NodeLLRsBlock);
+	free(Workspace->DecoderDecisions);
+	free(Workspace->SelectionKeys);
+	free(Workspace->SelectionCopies);
+	free(Workspace->Scratch);
+	free(Workspace->Candidates);
+	free(Workspace->Digests);
+	free(Workspace);
+}
 
-	//encode
-	uint8_t* CodeWord = PLC_Encode(MaskedFingerprint, NBytes);
+/// @brief Length (in bytes) of a decision row at the given depth: depth 0 -> root node, depth n -> plain text, else both children of a node at depth - 1.
+static uint32_t GetDecisionRowBytes(PLC_Context const*const Context, uint16_t const Depth)
+{
+	if(Depth == 0 || Depth == Context->n) return Context->NBytes;
+	return ((Context->N >> (Depth - 1)) + 7) / 8;
+}
 
-	free(MaskedFingerprint); MaskedFingerprint = 0;
-	if(CodeWord == 0) return 0;
+/// @brief Start index of a node's decisions within the decision row of its depth: the leaf index at depth n (plain text), else the node's half of its parent's children.
+/// @param StartIndex Start index of the node within its depth (node index * Size).
+static uint32_t GetDecisionIndex(PLC_Context const*const Context, uint16_t const Depth, uint32_t const StartIndex, uint32_t const Size)
+{
+	return Depth == Context->n ? StartIndex : (StartIndex & Size);
+}
 
-	//apply helper data
-	for(uint16_t i = 0, HDIndex = 0; i < N && (HDIndex / 8) < HelperDataSize; i++)
+/// @brief Creates a workspace for the code parameters of the given context -> allocates all memory needed for decoding.
+/// @return New workspace, nullptr on error.
+static PLC_Workspace* CreateWorkspace(PLC_Context const*const Context)
+{
+	uint32_t const N = Context->N;
+	uint16_t const n = Context->n;
+	uint8_t const NumberOfDecoders = Context->NumberOfDecoders;
+	uint32_t const NumberOfRows = (uint32_t)NumberOfDecoders * (n + 1);
+
+	uint32_t DecisionBytes = 0;
+	for(uint16_t Depth = 0; Depth < n + 1; Depth++) DecisionBytes += (uint32_t)NumberOfDecoders * GetDecisionRowBytes(Context, Depth);
+
+	PLC_Workspace* Workspace = calloc(1, sizeof(PLC_Workspace));
+	if(Workspace == 0) return 0;
+
+	Workspace->Pool = malloc(NumberOfDecoders * sizeof(DecoderData));
+	Workspace->LLRBlock = malloc((uint32_t)NumberOfDecoders * (2u * N - 1) * sizeof(BPSK_t));
+	Workspace->DecisionBlock = calloc(DecisionBytes, sizeof(Decision_t));
+	Workspace->DecisionRowOffsets = malloc((n + 1) * sizeof(uint32_t));
+	Workspace->LLRRows = malloc(NumberOfRows * sizeof(BPSK_t*));
+	Workspace->DecisionRows = malloc(NumberOfRows * sizeof(Decision_t*));
+	Workspace->DecoderLayers = malloc(NumberOfRows * sizeof(uint8_t));
+	Workspace->FreeDecoders = malloc(NumberOfDecoders * sizeof(DecoderData*));
+	Workspace->LayerReferences = malloc(NumberOfRows * sizeof(uint8_t));
+	Workspace->FreeLayers = malloc(NumberOfRows * sizeof(uint8_t));
+	Workspace->NumberFreeLayers = malloc((n + 1) * sizeof(uint8_t));
+	Workspace->ChannelLLRs = malloc(N * sizeof(BPSK_t));
+	Workspace->Decoders = malloc(NumberOfDecoders * sizeof(DecoderData*));
+	Workspace->NodeTypes = malloc(((1u << (n + 1)) - 1) * sizeof(NodeType));
+	Workspace->NodeBitsBlock = malloc(NumberOfDecoders * NumberOfDecoders * sizeof(uint32_t));
+	Workspace->NodeLLRsBlock = malloc(NumberOfDecoders * NumberOfDecoders * sizeof(BPSK_t));
+	Workspace->DecoderDecisions = malloc(2 * NumberOfDecoders * sizeof(DecoderDecision));
+	Workspace->SelectionKeys = malloc((2 * NumberOfDecoders > SelectionNetworkMaxLength ? 2 * NumberOfDecoders : SelectionNetworkMaxLength) * sizeof(uint64_t));
+	Workspace->SelectionCopies = malloc(NumberOfDecoders * sizeof(uint64_t));
+	Workspace->Scratch = malloc(2 * Context->NBytes * sizeof(uint8_t));
+	Workspace->Candidates = malloc(NumberOfDecoders * sizeof(uint8_t const*));
+	Workspace->Digests = malloc(NumberOfDecoders * PLC_MaxDigestLength * sizeof(uint8_t));
+
+	if(Workspace->Pool == 0 || Workspace->LLRBlock == 0 || Workspace->DecisionBlock == 0 || Workspace->DecisionRowOffsets == 0 || Workspace->LLRRows == 0 || Workspace->DecisionRows == 0 || Workspace->DecoderLayers == 0 ||
+	   Workspace->FreeDecoders == 0 || Workspace->LayerReferences == 0 || Workspace->FreeLayers == 0 || Workspace->NumberFreeLayers == 0 || Workspace->ChannelLLRs == 0 || Workspace->Decoders == 0 ||
+	   Workspace->NodeTypes == 0 || Workspace->NodeBitsBlock == 0 || Workspace->NodeLLRsBlock == 0 || Workspace->DecoderDecisions == 0 ||
+	   Workspace->SelectionKeys == 0 || Workspace->SelectionCopies == 0 || Workspace->Scratch == 0 ||
+	   Workspace->Candidates == 0 || Workspace->Digests == 0)
 	{
-		if(!GetBitAtIndex(FrozenBitMask, i))
-		{
-			SetBitAtIndex(CodeWord, i, GetBitAtIndex(HelperData, HDIndex));
-			HDIndex++;
-		}
+		DeleteWorkspace(Workspace);
+		return 0;
 	}
 
-	//decode
-	uint8_t** RecoveredFingerprints = PLC_SCL_Decode(CodeWord, NBytes, FrozenBitMask, FrozenBitMaskLength);
-
-	free(CodeWord); CodeWord = 0;
-	if(RecoveredFingerprints == 0) return 0;
+	Workspace->DecisionRowOffsets[0] = 0;
+	for(uint16_t Depth = 1; Depth < n + 1; Depth++)
+	{
+		Workspace->DecisionRowOffsets[Depth] = Workspace->DecisionRowOffsets[Depth - 1] + (uint32_t)NumberOfDecoders * GetDecisionRowBytes(Context, Depth - 1);
+	}
 
-	//get matching "recovered" fingerprint
-	uint8_t* RecoveredFingerprint = 0;
 	for(uint8_t i = 0; i < NumberOfDecoders; i++)
 	{
-		if(RecoveredFingerprint == 0 && RecoveredFingerprints[i] != 0)
-		{
-			uint8_t* HashedFingerprint = SHA1_Hash(RecoveredFingerprints[i], NBytes);
-
-			bool Match = HashedFingerprint != 0;
-			for(uint16_t j = 0; j < SHA1_ByteLength && j < ValidationHashLength && Match; j++)
-			{
-				Match = HashedFingerprint[j] == ValidationHash[j];
-			}
-			free(HashedFingerprint); HashedFingerprint = 0;
-
-			if(Match) RecoveredFingerprint = RecoveredFingerprints[i];
-			else
-			{
-				//not matching? free!
-				free(RecoveredFingerprints[i]); 
-				RecoveredFingerprints[i] = 0;
-			}
-		}
-		else
-		{
-			//already found match? free!
-			free(RecoveredFingerprints[i]); 
-			RecoveredFingerprints[i] = 0;
-		}
+		Workspace->Pool[i].LLRs = Workspace->LLRRows + i * (n + 1);
+		Workspace->Pool[i].Decisions = Workspace->DecisionRows + i * (n + 1);
+		Workspace->Pool[i].Layers = Workspace->DecoderLayers + i * (n + 1);
+		Workspace->Pool[i].NodeBits = Workspace->NodeBitsBlock + i * NumberOfDecoders;
+		Workspace->Pool[i].NodeLLRs = Workspace->NodeLLRsBlock + i * NumberOfDecoders;
+		Workspace->Pool[i].PathMetrics = 0;
 	}
-	free(RecoveredFingerprints); RecoveredFingerprints = 0;
 
-	if(RecoveredFingerprint == 0) return 0;
+	return Workspace;
+}
 
-	//encode
-	CodeWord = PLC_Encode(RecoveredFingerprint, NBytes);
-	free(RecoveredFingerprint); RecoveredFingerprint = 0;
+/// @brief Deletes a plan -> frees memory.
+static void DeletePlan(PLC_Plan* Plan)
+{
+	if(Plan == 0) return;
 
-	//extract raw key
-	uint8_t* RawKey = calloc(KBytes, sizeof(uint8_t));
-	for(uint16_t i = 0, RawKeyIndex = 0; i < N && RawKeyIndex < K; i++)
+	free(Plan->FrozenBitMask);
+	free(Plan->Instructions);
+	free(Plan);
+}
+
+/// @brief Deletes all cached plans of a context (-> plans are outdated).
+static void ClearPlans(PLC_Context *const Context)
+{
+	for(uint8_t i = 0; i < PlanCacheSize; i++)
 	{
-		if(GetBitAtIndex(FrozenBitMask, i))
-		{
-			SetBitAtIndex(RawKey, RawKeyIndex, GetBitAtIndex(CodeWord, i));
-			RawKeyIndex++;
-		}
+		DeletePlan(Context->Plans[i]);
+		Context->Plans[i] = 0;
 	}
-	free(CodeWord); CodeWord = 0;
+	Context->NextPlan = 0;
+}
 
-	//hash raw key
-	uint8_t* Key = SHA1_Hash(RawKey, KBytes);
-	free(RawKey); RawKey = 0;
+/// @brief Returns the default context, creates its workspace if not done yet (-> PLC_Init was not called).
+static PLC_Context* GetDefaultContext()
+{
+	if(DefaultContext.Kernels == 0) DefaultContext.Kernels = PLC_GetKernels(PLC_KernelLevel_Best);
+	if(DefaultContext.Hash == 0) DefaultContext.Hash = PLC_GetHashProvider(PLC_Hash_SHA1, true);
+	if(DefaultContext.Workspace == 0) DefaultContext.Workspace = CreateWorkspace(&DefaultContext);
 
-	return Key;
+	return &DefaultContext;
 }
 
-// --- ENCODE --- //
-uint8_t *PLC_Encode(uint8_t const *const Input, uint16_t const InputLength)
+void PLC_Init(uint32_t const N_, uint32_t const K_, uint8_t const _NumberOfDecoders)
 {
-	if(Input == 0 || InputLength < NBytes) return 0;
+	if(!SetupContext(&DefaultContext, N_, K_, _NumberOfDecoders)) return;
 
-	uint8_t* Values = malloc(NBytes);
-	memcpy(Values, Input, NBytes);
+	ClearPlans(&DefaultContext);
+	DeleteWorkspace(DefaultContext.Workspace);
+	DefaultContext.Workspace = CreateWorkspace(&DefaultContext);
+}
+
+PLC_Context* PLC_CreateContext(uint32_t const N, uint32_t const K, uint8_t const NumberOfDecoders)
+{
+	PLC_Context* Context = calloc(1, sizeof(PLC_Context));
+	if(Context == 0) return 0;
 
-	for (uint16_t m = 1; m < N; m *= 2)
+	if(!SetupContext(Context, N, K, NumberOfDecoders))
 	{
-		for (uint16_t i = 0; i < N; i += 2 * m)
-		{
-			uint8_t* a = CopyBitRange(Values, NBytes, i, i + m);
-			uint8_t* b = CopyBitRange(Values, NBytes, i + m, i + 2 * m);
+		free(Context);
+		return 0;
+	}
 
-			for (uint16_t j = 0; j < m; j++)
-			{
-				SetBitAtIndex(Values, i + j, GetBitAtIndex(a, j) ^ GetBitAtIndex(b, j));
-				SetBitAtIndex(Values, i + m + j, GetBitAtIndex(b, j));
-			}
-			
-			free(a);
-			free(b);
-		}
+	Context->Workspace = CreateWorkspace(Context);
+	if(Context->Workspace == 0)
+	{
+		free(Context);
+		return 0;
 	}
 
-	return Values;
+	return Context;
 }
 
-// --- DECODE - helper functions --- //
-
-/// @brief Min-sum approximation (often denoted as f)
-static BPSK_t MinSum(BPSK_t const a, BPSK_t const b)
+PLC_Context* PLC_CloneContext(PLC_Context const*const Context)
 {
-	BPSK_t sign = (a * b) > 0 ? 1 : -1;
+	PLC_Context const*const Source = Context == 0 ? &DefaultContext : Context;
+
+	PLC_Context* Clone = PLC_CreateContext(Source->N, Source->K, Source->NumberOfDecoders);
+	if(Clone == 0) return 0;
+
+	Clone->FastNodes = Source->FastNodes;
+	Clone->MaxListSize = Source->MaxListSize;
+	Clone->Systematic = Source->Systematic;
+	Clone->CodeWordOutput = Source->CodeWordOutput;
+	if(Source->Kernels != 0) Clone->Kernels = Source->Kernels;
+	if(Source->Hash != 0) Clone->Hash = Source->Hash;
+	if(Source->CRC.Length > 0 && !PLC_SetCRC(Clone, Source->CRC.Length, Source->CRC.Polynomial, Source->CRC.Checkpoints, Source->CRC.NumberOfCheckpoints))
+	{
+		PLC_DeleteContext(Clone);
+		return 0;
+	}
 
-	BPSK_t a_abs = a < 0 ? a * -1 : a;
-	BPSK_t b_abs = b < 0 ? b * -1 : b;
+	return Clone;
+}
 
-	BPSK_t min = a_abs < b_abs ? a_abs : b_abs;
+void PLC_DeleteContext(PLC_Context* Context)
+{
+	if(Context == 0) return;
 
-	return sign * min;
+	ClearPlans(Context);
+	DeleteWorkspace(Context->Workspace);
+	free(Context->CRC.Checkpoints);
+	free(Context);
 }
 
-/// @brief Min-sum approximation (often denoted as f), for two given arrays.
-static BPSK_t* MinSumArray(BPSK_t* A, BPSK_t* B, uint16_t const Length)
+void PLC_GetCodeParameters(PLC_Context const*const Context, uint32_t *const N, uint32_t *const K, uint8_t *const NumberOfDecoders)
 {
-	if(A == 0 || B == 0 || Length == 0) return 0;
+	PLC_Context const*const Source = Context == 0 ? &DefaultContext : Context;
 
-	BPSK_t* Values = calloc(Length, sizeof(BPSK_t));
-	for(uint16_t i = 0; i < Length; i++)
-	{
-		Values[i] = MinSum(A[i], B[i]);
-	}
+	if(N != 0) *N = Source->N;
+	if(K != 0) *K = Source->K;
+	if(NumberOfDecoders != 0) *NumberOfDecoders = Source->NumberOfDecoders;
+}
 
-	return Values;
+bool PLC_GetStats(PLC_Context const*const Context, PLC_Stats *const Stats)
+{
+	if(Stats == 0) return false;
+
+	#ifdef PLC_ENABLE_STATS
+		*Stats = (Context == 0 ? &DefaultContext : Context)->Stats;
+		return true;
+	#else
+		(void)Context;
+		memset(Stats, 0, sizeof(PLC_Stats));
+		return false;
+	#endif
 }
 
-/// @brief g-function in literature
-static BPSK_t g(BPSK_t const a, BPSK_t const b, Decision_t const c)
+void PLC_ResetStats(PLC_Context *const Context)
 {
-	return b + (1 - 2 * c) * a;
+	#ifdef PLC_ENABLE_STATS
+		memset(&(Context == 0 ? &DefaultContext : Context)->Stats, 0, sizeof(PLC_Stats));
+	#else
+		(void)Context;
+	#endif
 }
 
-/// @brief g-function in literature, for three given arrays.
-static BPSK_t* gArray(BPSK_t const*const A, BPSK_t const*const B, Decision_t const*const C, uint16_t const Length)
+bool PLC_SetFastNodes(PLC_Context *const Context, uint8_t const Flags)
 {
-	if(A == 0 || B == 0 || C == 0 || Length == 0) return 0;
+	if(Context == 0 || (Flags & ~PLC_FastNode_All) != 0) return false;
 
-	BPSK_t* Values = calloc(Length, sizeof(BPSK_t));
-	for(uint16_t i = 0; i < Length; i++)
-	{
-		Values[i] = g(A[i], B[i], GetBitAtIndex(C, i));
-	}
+	Context->FastNodes = Flags;
+	return true;
+}
 
-	return Values;
+bool PLC_SetAdaptiveListSize(PLC_Context *const Context, uint8_t const MaxListSize)
+{
+	if(Context == 0 || MaxListSize > Context->NumberOfDecoders) return false;
+
+	Context->MaxListSize = MaxListSize;
+	return true;
 }
 
-/// @brief BPSK encoding for a single bit.
-static BPSK_t ToBPSK(uint8_t const Bit)
+uint8_t PLC_GetEffectiveListSize(PLC_Context const*const Context)
 {
-	return Bit ? -1 : 1; // 1 -> -1 ; 0 -> 1
+	return Context != 0 ? Context->EffectiveListSize : 0;
 }
 
-//Node states
-typedef uint8_t NodeState;
-#define NS_Untouched 0
-#define NS_LeftDone 1
-#define NS_RightDone 2
-#define NS_Done 3
-#define NS_Error 4
+bool PLC_SetSystematic(PLC_Context *const Context, bool const Enable)
+{
+	if(Context == 0) return false;
+
+	Context->Systematic = Enable;
+	return true;
+}
 
-/// @brief Gets the node state for a specified node at specified depth.
-static NodeState GetNodeState(NodeState const*const NodeStates, uint16_t const Depth, uint16_t const Node)
+bool PLC_SetCodeWordOutput(PLC_Context *const Context, bool const Enable)
 {
-	if(NodeStates == 0) return NS_Error;
+	if(Context == 0) return false;
 
-	uint16_t const Position = (uint16_t)pow(2, Depth) + Node - 1;
-	return NodeStates[Position];
+	Context->CodeWordOutput = Enable;
+	return true;
 }
 
-/// @brief Sets the node state for a specified node at specified depth.
-static void SetNodeState(NodeState *const NodeStates, uint16_t Depth, uint16_t const Node, NodeState const State)
+bool PLC_SetHashProvider(PLC_Context *const Context, PLC_HashProvider const*const Provider)
 {
-	if(NodeStates == 0) return;
+	if(Context == 0) return false;
+	if(Provider == 0)
+	{
+		Context->Hash = PLC_GetHashProvider(PLC_Hash_SHA1, true);
+		return true;
+	}
+	if(Provider->Hash == 0 || Provider->DigestLength == 0 || Provider->DigestLength > PLC_MaxDigestLength) return false;
 
-	uint16_t const Position = (uint16_t)pow(2, Depth) + Node - 1;
-	NodeStates[Position] = State;
+	Context->Hash = Provider;
+	return true;
 }
 
-typedef struct
+uint8_t PLC_GetKeyLength(PLC_Context const*const Context)
 {
-	BPSK_t** LLRs;
-	Decision_t** Decisions;
-	int16_t PathMetrics;
-} DecoderData;
+	PLC_Context const*const Source = Context == 0 ? &DefaultContext : Context;
+	return Source->Hash != 0 ? Source->Hash->DigestLength : OutputKeyLengthByte;
+}
 
-/// @brief Creates a new decoder -> allocates memory.
-static DecoderData* CreateDecoder()
+/// @brief Counts the information (non-frozen) bits of a frozen bit mask of NBytes bytes.
+static uint32_t CountInfoBits(uint8_t const *const FrozenBitMask, uint32_t const NBytes)
 {
-	DecoderData* Data = malloc(sizeof(DecoderData));
-	Data->PathMetrics = 0;
-	Data->LLRs = malloc((n + 1) * sizeof(BPSK_t*));
-	Data->Decisions = malloc((n + 1) * sizeof(Decision_t*));
-	for(uint16_t i = 0; i < n + 1; i++)
+	uint32_t Count = 0;
+	for(uint32_t i = 0; i < NBytes; i++)
 	{
-		Data->LLRs[i] = malloc(N * sizeof(BPSK_t));
-		Data->Decisions[i] = calloc(((uint16_t)ceil(N / 8.0)), sizeof(Decision_t));
+		for(uint8_t Byte = FrozenBitMask[i]; Byte != 0; Byte &= (uint8_t)(Byte - 1)) Count++;
 	}
+	return Count;
+}
 
-	return Data;
+// --- CRC --- //
+
+/// @brief Shifts a single bit into a CRC register (MSB first).
+static uint16_t UpdateCRC(PLC_CRCConfig const*const CRC, uint16_t Register, uint8_t const Bit)
+{
+	uint16_t const Mask = (uint16_t)((1u << CRC->Length) - 1);
+	uint8_t const Feedback = ((Register >> (CRC->Length - 1)) ^ Bit) & 0x01;
+
+	Register = (Register << 1) & Mask;
+	if(Feedback) Register ^= CRC->Polynomial & Mask;
+
+	return Register;
 }
 
-/// @brief Deletes a decoders -> frees memory.
-static void DeleteDecoder(DecoderData* Data)
+bool PLC_SetCRC(PLC_Context *const Context, uint8_t const Length, uint16_t const Polynomial,
+				uint32_t const *const Checkpoints, uint8_t const NumberOfCheckpoints)
 {
-	if(Data == 0) return;
+	if(Context == 0 || Length > 16) return false;
 
-	for(uint16_t i = 0; i < n + 1; i++)
+	free(Context->CRC.Checkpoints);
+	Context->CRC.Checkpoints = 0;
+	Context->CRC.NumberOfCheckpoints = 0;
+	Context->CRC.Length = 0;
+
+	if(Length == 0) return true; // -> disable
+
+	uint8_t const Count = Checkpoints == 0 ? 1 : NumberOfCheckpoints;
+	if(Count == 0) return false;
+
+	uint32_t* CheckpointsCopy = malloc(Count * sizeof(uint32_t));
+	if(CheckpointsCopy == 0) return false;
+
+	for(uint8_t i = 0; i < Count; i++)
 	{
-		free(Data->LLRs[i]);
-		free(Data->Decisions[i]);
+		CheckpointsCopy[i] = Checkpoints == 0 ? Context->K - 1 : Checkpoints[i]; // default: single CRC over all information bits
+		if(CheckpointsCopy[i] >= Context->K || (i > 0 && CheckpointsCopy[i] <= CheckpointsCopy[i - 1]))
+		{
+			free(CheckpointsCopy);
+			return false;
+		}
 	}
-	free(Data->LLRs);
-	free(Data->Decisions);
-	free(Data);
+
+	Context->CRC.Length = Length;
+	Context->CRC.Polynomial = Polynomial;
+	Context->CRC.Checkpoints = CheckpointsCopy;
+	Context->CRC.NumberOfCheckpoints = Count;
+	return true;
 }
 
-/// @brief Allocates a new decoder and copies all values from given decoder.
-static DecoderData* CopyDecoder(DecoderData const*const Dec1)
+uint8_t PLC_ComputeCRC(PLC_Context const *const Context, uint8_t const *const Input, uint32_t const InputLength,
+					   uint8_t const *const FrozenBitMask, uint32_t const FrozenBitMaskLength, uint16_t *const CRCValues)
 {
-	if(Dec1 == 0) return 0;
+	if(Context == 0 || Context->CRC.Length == 0) return 0;
+	if(Input == 0 || InputLength < Context->NBytes || CRCValues == 0) return 0;
+	if(FrozenBitMask == 0 || FrozenBitMaskLength != Context->NBytes) return 0;
 
-	DecoderData* Dec2 = CreateDecoder();
+	PLC_CRCConfig const*const CRC = &Context->CRC;
+	uint16_t Register = 0;
+	uint8_t Checkpoint = 0;
 
-	Dec2->PathMetrics = Dec1->PathMetrics;
-	for(uint16_t i = 0; i < n + 1; i++)
+	for(uint32_t i = 0, InfoBitIndex = 0; i < Context->N && Checkpoint < CRC->NumberOfCheckpoints; i++)
 	{
-		memcpy(Dec2->LLRs[i], Dec1->LLRs[i], N * sizeof(BPSK_t));
-		memcpy(Dec2->Decisions[i], Dec1->Decisions[i], ((uint16_t)ceil(N / 8.0)) * sizeof(Decision_t));
+		if(!GetBitAtIndex(FrozenBitMask, i)) continue;
+
+		Register = UpdateCRC(CRC, Register, GetBitAtIndex(Input, i));
+		if(InfoBitIndex == CRC->Checkpoints[Checkpoint])
+		{
+			CRCValues[Checkpoint++] = Register;
+			Register = 0;
+		}
+		InfoBitIndex++;
 	}
 
-	return Dec2;
+	return Checkpoint;
 }
 
-/// @brief Gets a LLR (Log Likelihood Ratio) from the specified decoder, at depth and (node) index.
-static BPSK_t GetLLR(DecoderData const*const Decoder, uint16_t const Depth, uint16_t const Index)
+/// @brief Reads the expected CRC values, they are stored behind the frozen bits in the helper data (2 bytes each, little endian).
+/// @param CRCValues Output, one value per checkpoint.
+/// @return True on success, false if the helper data is too short.
+static bool ReadCRCValues(PLC_Context const*const Context, uint8_t const *const HelperData, uint32_t const HelperDataSize, uint16_t *const CRCValues)
 {
-	if(Decoder == 0 || Decoder->LLRs == 0) return 0;
+	uint32_t const Offset = (Context->N - Context->K + 7) / 8;
+	if(HelperDataSize < Offset + 2 * Context->CRC.NumberOfCheckpoints) return false;
 
-	return Decoder->LLRs[Depth][Index];
+	for(uint8_t i = 0; i < Context->CRC.NumberOfCheckpoints; i++)
+	{
+		CRCValues[i] = HelperData[Offset + 2 * i] | (HelperData[Offset + 2 * i + 1] << 8);
+	}
+	return true;
 }
 
-/// @brief Gets a LLR (Log Likelihood Ratio) range from the specified decoder, at depth from StartIndex to EndIndex.
-static BPSK_t* GetLLRRange(DecoderData const*const Decoder, uint16_t const Depth, uint16_t const StartIndex, uint16_t const EndIndex)
+// --- REPRODUCE --- //
+
+static bool DecodeAndDeriveKey(PLC_Context *const Context, uint8_t const *const Input, uint8_t const *const FrozenBitMask, uint16_t const *const CRCValues,
+							   uint8_t const *const ValidationHash, uint8_t *const Key); // -> REPRODUCE - decoding passes
+
+/// @brief Derives the key from a code word: hash of its non-frozen bits (raw key, extracted into Workspace->Scratch + NBytes).
+/// @param Key Output, DigestLength bytes.
+/// @return True on success, false if hashing failed.
+static bool HashRawKey(PLC_Context *const Context, uint8_t const *const CodeWord, uint8_t const *const FrozenBitMask, uint8_t *const Key)
 {
-	if(Decoder == 0 || Decoder->LLRs == 0 || EndIndex <= StartIndex) return 0;
+	uint32_t const N = Context->N;
+	uint32_t const NBytes = Context->NBytes;
+	uint32_t const K = Context->K;
+	uint8_t *const RawKey = Context->Workspace->Scratch + NBytes;
+
+	//extract raw key
+	memset(RawKey, 0, NBytes);
+	for(uint32_t i = 0, RawKeyIndex = 0; i < N && RawKeyIndex < K; i++)
+	{
+		if(GetBitAtIndex(FrozenBitMask, i))
+		{
+			SetBitAtIndex(RawKey, RawKeyIndex, GetBitAtIndex(CodeWord, i));
+			RawKeyIndex++;
+		}
+	}
+
+	//hash raw key
+	STATS_START(Lap);
+	bool const Success = HashValues(Context, RawKey, Context->KBytes, Key);
+	STATS_LAP(Context, PLC_Stage_Hash, Lap);
 
-	uint16_t const Length = EndIndex - StartIndex;
-	BPSK_t* Values = malloc(Length * sizeof(BPSK_t));
+	return Success;
+}
 
-	for(uint16_t i = 0; i < Length; i++)
+/// @brief Checks a decoded plain text against the validation hash and derives the key from its code word (no heap allocations, uses Workspace->Scratch).
+/// @param CodeWord Code word estimate of the decoder (-> no re-encoding).
+/// @param Hash Digest of the plain text, nullptr -> hashed here.
+/// @param Key Output, DigestLength bytes.
+/// @return True if the plain text matches the validation hash and the key was derived.
+static bool DeriveKey(PLC_Context *const Context, uint8_t const *const PlainText, uint8_t const *const CodeWord, uint8_t const *const FrozenBitMask,
+					  uint8_t const *const Hash, uint8_t const *const ValidationHash, uint8_t *const Key)
+{
+	//matching "recovered" fingerprint?
+	uint8_t Digest[PLC_MaxDigestLength];
+	if(Hash == 0)
 	{
-		Values[i] = GetLLR(Decoder, Depth, i + StartIndex);
+		STATS_START(Lap);
+		bool const Hashed = HashValues(Context, PlainText, Context->NBytes, Digest);
+		STATS_LAP(Context, PLC_Stage_Hash, Lap);
+		if(!Hashed) return false;
 	}
+	if(memcmp(Hash != 0 ? Hash : Digest, ValidationHash, Context->Hash->DigestLength) != 0) return false;
 
-	return Values;
+	return HashRawKey(Context, CodeWord, FrozenBitMask, Key);
+}
+
+uint8_t *PLC_Reproduce(
+	uint8_t const *const Fingerprint, uint32_t const FingerprintLength,
+	uint8_t const *const HelperData, uint32_t const HelperDataSize,
+	uint8_t const *const FrozenBitMask, uint32_t const FrozenBitMaskLength,
+	uint8_t const *const ValidationHash, uint16_t const ValidationHashLength)
+{
+	return PLC_Reproduce_Ctx(GetDefaultContext(), Fingerprint, FingerprintLength, HelperData, HelperDataSize, FrozenBitMask, FrozenBitMaskLength, ValidationHash, ValidationHashLength);
 }
 
-/// @brief Sets a LLR (Log Likelihood Ratio) range of the specified decoder, at depth from StartIndex to EndIndex.
-static void SetLLRRange(DecoderData *const Decoder, uint16_t const Depth, uint16_t const StartIndex, uint16_t const EndIndex, BPSK_t const*const Values)
+uint8_t *PLC_Reproduce_Ctx(PLC_Context *const Context,
+	uint8_t const *const Fingerprint, uint32_t const FingerprintLength,
+	uint8_t const *const HelperData, uint32_t const HelperDataSize,
+	uint8_t const *const FrozenBitMask, uint32_t const FrozenBitMaskLength,
+	uint8_t const *const ValidationHash, uint16_t const ValidationHashLength)
 {
-	if(Decoder == 0 || Decoder->LLRs == 0 || Values == 0 || EndIndex <= StartIndex) return;
+	if(Context == 0) return 0;
 
-	uint16_t const Length = EndIndex - StartIndex;
-	for(uint16_t i = 0; i < Length; i++)
+	uint8_t* Key = malloc(Context->Hash->DigestLength);
+	if(Key == 0) return 0;
+	STATS_ADD(Context, Allocations, 1);
+
+	if(!PLC_Reproduce_Into(Context, Fingerprint, FingerprintLength, HelperData, HelperDataSize, FrozenBitMask, FrozenBitMaskLength,
+						   ValidationHash, ValidationHashLength, Key, Context->Hash->DigestLength))
 	{
-		Decoder->LLRs[Depth][i + StartIndex] = Values[i];
+		free(Key);
+		return 0;
 	}
+
+	return Key;
 }
 
-/// @brief Gets a decoders decisions for a given depth in a given range.
-static Decision_t* GetDecisionsRange(DecoderData const*const Decoder, uint16_t const Depth, uint16_t const StartIndex, uint16_t const EndIndex)
+bool PLC_Reproduce_Into(PLC_Context *const Context_,
+	uint8_t const *const Fingerprint, uint32_t const FingerprintLength,
+	uint8_t const *const HelperData, uint32_t const HelperDataSize,
+	uint8_t const *const FrozenBitMask, uint32_t const FrozenBitMaskLength,
+	uint8_t const *const ValidationHash, uint16_t const ValidationHashLength,
+	uint8_t *const Key, uint16_t const KeyLength)
 {
-	if(Decoder == 0 || Decoder->Decisions == 0 || EndIndex <= StartIndex) return 0;
+	PLC_Context *const Context = Context_ != 0 ? Context_ : GetDefaultContext();
+	if(Context->Workspace == 0) return false;
+	uint32_t const N = Context->N;
+	uint32_t const NBytes = Context->NBytes;
+	Context->EffectiveListSize = 0;
+
+	if(Fingerprint == 0 || FingerprintLength < NBytes) return false;
+	if(HelperData == 0 || HelperDataSize < PLC_GetHelperDataSize(Context)) return false; // as written by PLC_Enroll (K = N -> no frozen bits, 0 bytes)
+	if(FrozenBitMask == 0 || FrozenBitMaskLength != NBytes || CountInfoBits(FrozenBitMask, NBytes) != Context->K) return false; // K information bits -> N - K helper bits
+	if(ValidationHash == 0 || ValidationHashLength != Context->Hash->DigestLength) return false;
+	if(Key == 0 || KeyLength < Context->Hash->DigestLength) return false;
+
+	//apply frozen bit mask
+	uint8_t *const CodeWord = Context->Workspace->Scratch; // consumed as decoder input before the scratch is used again
+	for(uint32_t i = 0; i < NBytes; i++)
+	{
+		CodeWord[i] = Fingerprint[i] & FrozenBitMask[i];
+	}
 
-	uint16_t const Length = EndIndex - StartIndex;
-	Decision_t *const Values = calloc((uint16_t)ceil(Length / 8.0), sizeof(Decision_t));
+	//encode (systematic code: the fingerprint bits are the information bits of the code word)
+	if(!Context->Systematic && !PLC_Encode_InPlace(Context, CodeWord, NBytes)) return false;
 
-	for(uint16_t i = 0; i < Length; i++)
+	//apply helper data
+	for(uint32_t i = 0, HDIndex = 0; i < N && (HDIndex / 8) < HelperDataSize; i++)
 	{
-		SetBitAtIndex(Values, i, GetBitAtIndex(Decoder->Decisions[Depth], i + StartIndex));
+		if(!GetBitAtIndex(FrozenBitMask, i))
+		{
+			SetBitAtIndex(CodeWord, i, GetBitAtIndex(HelperData, HDIndex));
+			HDIndex++;
+		}
 	}
 
-	return Values;
+	//decode, CRC aided -> only the validated winner is left, the hash is the final confirmation
+	bool const UseCRC = Context->CRC.Length > 0;
+	uint16_t *const CRCValues = Context->Workspace->CRCValues;
+	if(UseCRC && !ReadCRCValues(Context, HelperData, HelperDataSize, CRCValues)) return false;
+
+	return DecodeAndDeriveKey(Context, CodeWord, FrozenBitMask, UseCRC ? CRCValues : 0, ValidationHash, Key);
 }
 
-/// @brief Sets a decoders decision at a given depth and index.
-static void SetDecision(DecoderData *const Decoder, uint16_t const Depth, uint16_t const Index, Decision_t const Decision)
-{
-	if(Decoder == 0 || Decoder->Decisions == 0) return;
+// --- ENROLL --- //
 
-	SetBitAtIndex(Decoder->Decisions[Depth], Index, Decision);
+uint32_t PLC_GetHelperDataSize(PLC_Context const*const Context)
+{
+	PLC_Context const*const Source = Context == 0 ? &DefaultContext : Context;
+	return ((Source->N - Source->K + 7) / 8 + (Source->CRC.Length > 0 ? 2 * Source->CRC.NumberOfCheckpoints : 0));
 }
 
-/// @brief Sets a decoders decisions at given depth in a given range.
-static void SetDecisionsRange(DecoderData *const Decoder, uint16_t const Depth, uint16_t const StartIndex, uint16_t const EndIndex, Decision_t const*const Decisions)
+bool PLC_Enroll(PLC_Context *const Context_,
+	uint8_t const *const Fingerprint, uint32_t const FingerprintLength,
+	uint8_t const *const FrozenBitMask, uint32_t const FrozenBitMaskLength,
+	uint8_t *const HelperData, uint32_t const HelperDataSize,
+	uint8_t *const ValidationHash, uint16_t const ValidationHashLength,
+	uint8_t *const Key, uint16_t const KeyLength)
 {
-	if(Decoder == 0 || Decoder->Decisions == 0 || Decisions == 0 || EndIndex <= StartIndex) return;
+	PLC_Context *const Context = Context_ != 0 ? Context_ : GetDefaultContext();
+	if(Context->Workspace == 0) return false;
+	uint32_t const N = Context->N;
+	uint32_t const NBytes = Context->NBytes;
+
+	if(Fingerprint == 0 || FingerprintLength < NBytes) return false;
+	if(FrozenBitMask == 0 || FrozenBitMaskLength != NBytes || CountInfoBits(FrozenBitMask, NBytes) != Context->K) return false; // K information bits -> N - K helper bits
+	if(HelperData == 0 || HelperDataSize < PLC_GetHelperDataSize(Context)) return false;
+	if(ValidationHash == 0 || ValidationHashLength != Context->Hash->DigestLength) return false;
+	if(Key == 0 || KeyLength < Context->Hash->DigestLength) return false;
+
+	//code word (systematic code: carries the fingerprint bits at the non-frozen positions) and plain text
+	uint8_t *const Word = Context->Workspace->Scratch; // code word, then plain text (Scratch + NBytes: raw key)
+	if(Context->Systematic)
+	{
+		if(!PLC_Encode_Systematic(Context, Fingerprint, FingerprintLength, FrozenBitMask, FrozenBitMaskLength, Word, NBytes)) return false;
+	}
+	else
+	{
+		for(uint32_t i = 0; i < NBytes; i++)
+		{
+			Word[i] = Fingerprint[i] & FrozenBitMask[i];
+		}
+		if(!PLC_Encode_InPlace(Context, Word, NBytes)) return false;
+	}
+
+	if(!HashRawKey(Context, Word, FrozenBitMask, Key)) return false;
 
-	uint16_t const Length = EndIndex - StartIndex;
-	for(uint16_t i = 0; i < Length; i++)
+	//helper data: values of the frozen bits of the code word
+	memset(HelperData, 0, (N - Context->K + 7) / 8);
+	for(uint32_t i = 0, HDIndex = 0; i < N; i++)
 	{
-		SetDecision(Decoder, Depth, StartIndex + i, GetBitAtIndex(Decisions, i));
+		if(!GetBitAtIndex(FrozenBitMask, i))
+		{
+			SetBitAtIndex(HelperData, HDIndex, GetBitAtIndex(Word, i));
+			HDIndex++;
+		}
 	}
-}
 
-/// @brief Adds additional metric to decoder's path metric
-static void AddPathMetric(DecoderData *const Decoder, int const Metric)
-{
-	if(Decoder == 0) return;
+	//plain text (F^(xn) is its own inverse) -> validation hash, CRC values
+	if(!PLC_Encode_InPlace(Context, Word, NBytes)) return false;
+
+	STATS_START(Lap);
+	bool const Hashed = HashValues(Context, Word, NBytes, ValidationHash);
+	STATS_LAP(Context, PLC_Stage_Hash, Lap);
+	if(!Hashed) return false;
+
+	if(Context->CRC.Length > 0)
+	{
+		uint32_t const Offset = (N - Context->K + 7) / 8;
+		uint16_t *const CRCValues = Context->Workspace->CRCValues;
+		if(PLC_ComputeCRC(Context, Word, NBytes, FrozenBitMask, FrozenBitMaskLength, CRCValues) != Context->CRC.NumberOfCheckpoints) return false;
+
+		for(uint8_t i = 0; i < Context->CRC.NumberOfCheckpoints; i++)
+		{
+			HelperData[Offset + 2 * i] = (uint8_t)CRCValues[i];
+			HelperData[Offset + 2 * i + 1] = (uint8_t)(CRCValues[i] >> 8);
+		}
+	}
 
-	Decoder->PathMetrics += Metric;
+	return true;
 }
 
-typedef struct {
-	uint8_t DecoderId;
-	int16_t PathMetric;
-	BPSK_t Decision;
-} DecoderDecision;
+// --- ENCODE --- //
 
-/// @brief Compares DecoderDecisions, based on path metric.
-/// @return -1 when path metric of Dec1 < Dec2; 0 when path metric of Dec1 == Dec2; 1 when path metric of Dec1 > Dec2.
-int CompareDecoderDecisions(const void* _Dec1, const void* _Dec2)
+/// @brief Loads 8 bytes as 64 bit word (bit i of the buffer -> bit i of the word, independent of the platform's endianness).
+static uint64_t LoadWord(uint8_t const*const Buffer)
 {
-	DecoderDecision const*const Dec1 = (DecoderDecision const*const)_Dec1;
-	DecoderDecision const*const Dec2 = (DecoderDecision const*const)_Dec2;
+	// written out -> compilers merge this into a single load on little endian platforms
+	return (uint64_t)Buffer[0] | ((uint64_t)Buffer[1] << 8) | ((uint64_t)Buffer[2] << 16) | ((uint64_t)Buffer[3] << 24) |
+		   ((uint64_t)Buffer[4] << 32) | ((uint64_t)Buffer[5] << 40) | ((uint64_t)Buffer[6] << 48) | ((uint64_t)Buffer[7] << 56);
+}
 
-	return Dec1->PathMetric < Dec2->PathMetric ? -1 : (Dec1->PathMetric == Dec2->PathMetric ? 0 : 1);
+/// @brief Stores a 64 bit word as 8 bytes (bit i of the word -> bit i of the buffer, independent of the platform's endianness).
+static void StoreWord(uint8_t *const Buffer, uint64_t const Word)
+{
+	Buffer[0] = (uint8_t)Word;			Buffer[1] = (uint8_t)(Word >> 8);
+	Buffer[2] = (uint8_t)(Word >> 16);	Buffer[3] = (uint8_t)(Word >> 24);
+	Buffer[4] = (uint8_t)(Word >> 32);	Buffer[5] = (uint8_t)(Word >> 40);
+	Buffer[6] = (uint8_t)(Word >> 48);	Buffer[7] = (uint8_t)(Word >> 56);
 }
 
-// --- DECODE --- //
-uint8_t **PLC_SCL_Decode(uint8_t const *const Input, uint16_t const InputLength,
-					   uint8_t const *const FrozenBitMask, uint16_t const FrozenBitMaskLength)
+/// @brief Applies all butterfly stages with m < 64 (and m < N) to a single word.
+static uint64_t EncodeWord(uint64_t Word, uint32_t const N)
 {
-	if(Input == 0 || InputLength < NBytes) return 0;
-	if(FrozenBitMask == 0 || FrozenBitMaskLength != NBytes) return 0;
+	// selects the first half of every block of length 2m
+	static uint64_t const StageMasks[6] = {
+		0x5555555555555555ull, 0x3333333333333333ull, 0x0F0F0F0F0F0F0F0Full,
+		0x00FF00FF00FF00FFull, 0x0000FFFF0000FFFFull, 0x00000000FFFFFFFFull
+	};
 
-	NodeState* NodeStates = calloc(((uint16_t)pow(2, n + 1) - 1), sizeof(NodeState));
-	DecoderData** Decoders = malloc(NumberOfDecoders * sizeof(DecoderData*));
-	for(uint8_t i = 0; i < NumberOfDecoders; i++)
+	for(uint8_t Stage = 0, m = 1; Stage < 6 && m < N; Stage++, m *= 2)
 	{
-		Decoders[i] = 0;
+		Word ^= (Word >> m) & StageMasks[Stage];
 	}
+	return Word;
+}
 
-	uint8_t CurrentDecoders = 1;
-	int Depth = 0;
-	uint16_t Node = 0;
-	bool Done = false;
+/// @brief In-place butterfly encoder, operating on 64 bit words.
+/// Stages with m < 64 are done within a word (shift + mask), larger stages XOR whole words.
+static void EncodeInPlace(uint8_t *const Values, uint32_t const N)
+{
+	if(N < 64) // -> less than a single word
+	{
+		uint8_t Word[8] = {0};
+		memcpy(Word, Values, N / 8);
+		StoreWord(Word, EncodeWord(LoadWord(Word), N));
+		memcpy(Values, Word, N / 8);
+		return;
+	}
 
-	//create initial decoder and add input values BPSK encoded
-	DecoderData* InitialDecoder = CreateDecoder();
-	for(uint16_t i = 0; i < N; i++)
+	for(uint32_t i = 0; i < N / 8; i += 8)
 	{
-		InitialDecoder->LLRs[Depth][i] = ToBPSK(GetBitAtIndex(Input, i));
+		StoreWord(Values + i, EncodeWord(LoadWord(Values + i), N));
 	}
-	Decoders[0] = InitialDecoder; InitialDecoder = 0;
 
-	while(!Done)
+	for(uint32_t m = 64; m < N; m *= 2)
 	{
-		if(Depth == n) // -> leaf node
+		uint32_t const mBytes = m / 8;
+		for(uint32_t i = 0; i < N / 8; i += 2 * mBytes)
 		{
-			if(!GetBitAtIndex(FrozenBitMask, Node)) // bit is frozen
+			for(uint32_t j = 0; j < mBytes; j += 8)
 			{
-				for(uint8_t i = 0; i < CurrentDecoders; i++)
-				{
-					BPSK_t DecisionMetric = GetLLR(Decoders[i], Depth, Node);
-					SetDecision(Decoders[i], Depth, Node, 0); // bit is frozen -> value is set to 0 (-> "frozen") during encoding
-					if(DecisionMetric < 0) AddPathMetric(Decoders[i], abs(DecisionMetric));
-				}
+				StoreWord(Values + i + j, LoadWord(Values + i + j) ^ LoadWord(Values + i + mBytes + j));
 			}
-			else // bit is not frozen
-			{
-				//get both possible decisions (+path metric) for each decoder
-				DecoderDecision* DecoderDecisions = malloc(2 * NumberOfDecoders * sizeof(DecoderDecision));
-				memset(DecoderDecisions, 0, 2 * NumberOfDecoders * sizeof(DecoderDecision));
+		}
+	}
+}
 
-				for(uint8_t i = 0; i < CurrentDecoders; i++)
-				{
-					BPSK_t const DecisionMetric = GetLLR(Decoders[i], Depth, Node);
-					Decision_t const Decision = DecisionMetric < 0 ? 1 : 0;
-					Decision_t const InverseDecision = DecisionMetric >= 0 ? 1 : 0;
+uint8_t *PLC_Encode(uint8_t const *const Input, uint32_t const InputLength)
+{
+	return PLC_Encode_Ctx(GetDefaultContext(), Input, InputLength);
+}
 
-					DecoderDecisions[i].Decision = Decision;
-					DecoderDecisions[i].DecoderId = i;
-					DecoderDecisions[i].PathMetric = Decoders[i]->PathMetrics;
+uint8_t *PLC_Encode_Ctx(PLC_Context const *const Context, uint8_t const *const Input, uint32_t const InputLength)
+{
+	if(Context == 0) return 0;
+	uint32_t const NBytes = Context->NBytes;
 
-					int16_t const CopiedPathMetric = Decoders[i]->PathMetrics + abs(DecisionMetric);
-					DecoderDecisions[i + CurrentDecoders].Decision = InverseDecision;
-					DecoderDecisions[i + CurrentDecoders].DecoderId = i;
-					DecoderDecisions[i + CurrentDecoders].PathMetric = CopiedPathMetric;
-				}
+	if(Input == 0 || InputLength < NBytes) return 0;
 
-				//sort decisions by viability (-> lowest path metric)
-				qsort(DecoderDecisions, CurrentDecoders * 2, sizeof(DecoderDecision), CompareDecoderDecisions);
+	uint8_t* Values = malloc(NBytes);
+	if(Values == 0) return 0;
+	STATS_ADD(Context, Allocations, 1);
+
+	STATS_START(Lap);
+	memcpy(Values, Input, NBytes);
+	EncodeInPlace(Values, Context->N);
+	STATS_LAP(Context, PLC_Stage_Encode, Lap);
+
+	return Values;
+}
+
+bool PLC_Encode_InPlace(PLC_Context const *const Context, uint8_t *const Values, uint32_t const ValuesLength)
+{
+	if(Context == 0 || Values == 0 || ValuesLength < Context->NBytes) return false;
+
+	STATS_START(Lap);
+	EncodeInPlace(Values, Context->N);
+	STATS_LAP(Context, PLC_Stage_Encode, Lap);
+	return true;
+}
+
+bool PLC_Encode_Into(PLC_Context const *const Context_, uint8_t const *const Input, uint32_t const InputLength, uint8_t *const Output, uint32_t const OutputLength)
+{
+	PLC_Context const*const Context = Context_ != 0 ? Context_ : GetDefaultContext();
+	uint32_t const NBytes = Context->NBytes;
+
+	if(Input == 0 || InputLength < NBytes) return false;
+	if(Output == 0 || OutputLength < NBytes) return false;
+
+	STATS_START(Lap);
+	memmove(Output, Input, NBytes);
+	EncodeInPlace(Output, Context->N);
+	STATS_LAP(Context, PLC_Stage_Encode, Lap);
+	return true;
+}
+
+bool PLC_Encode_Systematic(PLC_Context const *const Context_, uint8_t const *const Input, uint32_t const InputLength,
+						   uint8_t const *const FrozenBitMask, uint32_t const FrozenBitMaskLength, uint8_t *const Output, uint32_t const OutputLength)
+{
+	PLC_Context const*const Context = Context_ != 0 ? Context_ : GetDefaultContext();
+	uint32_t const NBytes = Context->NBytes;
+
+	if(Input == 0 || InputLength < NBytes) return false;
+	if(FrozenBitMask == 0 || FrozenBitMaskLength != NBytes) return false;
+	if(Output == 0 || OutputLength < NBytes || Output == Input) return false;
+
+	//encode - freeze - encode: x = u F^(xn) with u = ((v & mask) F^(xn)) & mask (F^(xn) is its own inverse)
+	STATS_START(Lap);
+	for(uint32_t i = 0; i < NBytes; i++)
+	{
+		Output[i] = Input[i] & FrozenBitMask[i];
+	}
+	EncodeInPlace(Output, Context->N);
+	for(uint32_t i = 0; i < NBytes; i++)
+	{
+		Output[i] &= FrozenBitMask[i];
+	}
+	EncodeInPlace(Output, Context->N);
+	STATS_LAP(Context, PLC_Stage_Encode, Lap);
+
+	//x_A = v_A only holds for domination contiguous information sets (e.g. most reliable bit channels) -> check
+	for(uint32_t i = 0; i < NBytes; i++)
+	{
+		if(((Output[i] ^ Input[i]) & FrozenBitMask[i]) != 0) return false;
+	}
+	return true;
+}
+
+// --- DECODE - helper functions --- //
+
+/// @brief BPSK encoding for a single bit.
+static BPSK_t ToBPSK(uint8_t const Bit)
+{
+	return Bit ? -1 : 1; // 1 -> -1 ; 0 -> 1
+}
+
+/// @brief Marks all decoders and layers of the workspace as unused.
+static void ResetWorkspace(PLC_Context const*const Context)
+{
+	PLC_Workspace *const Workspace = Context->Workspace;
+	uint8_t const NumberOfDecoders = Context->NumberOfDecoders;
+
+	for(uint8_t i = 0; i < NumberOfDecoders; i++)
+	{
+		Workspace->Decoders[i] = 0;
+		Workspace->FreeDecoders[i] = &Workspace->Pool[i];
+	}
+	Workspace->NumberFreeDecoders = NumberOfDecoders;
+
+	for(uint16_t Depth = 0; Depth < Context->n + 1; Depth++)
+	{
+		for(uint8_t i = 0; i < NumberOfDecoders; i++)
+		{
+			Workspace->LayerReferences[Depth * NumberOfDecoders + i] = 0;
+			Workspace->FreeLayers[Depth * NumberOfDecoders + i] = i;
+		}
+		Workspace->NumberFreeLayers[Depth] = NumberOfDecoders;
+	}
+}
+
+/// @brief Takes an unused layer slot at the given depth and lets the decoder reference it.
+/// @return True on success, false if all layer slots at this depth are in use.
+static bool AssignNewLayer(PLC_Context const*const Context, DecoderData *const Decoder, uint16_t const Depth)
+{
+	PLC_Workspace *const Workspace = Context->Workspace;
+	uint8_t const NumberOfDecoders = Context->NumberOfDecoders;
+
+	if(Workspace->NumberFreeLayers[Depth] == 0) return false;
+
+	uint8_t const Layer = Workspace->FreeLayers[Depth * NumberOfDecoders + --Workspace->NumberFreeLayers[Depth]];
+	uint32_t const Row = (uint32_t)Depth * NumberOfDecoders + Layer;
+
+	//depths before this one: sum of N >> d LLRs per slot = 2N - 2 (N >> Depth)
+	uint32_t const LLRLength = Context->N >> Depth;
+	uint32_t const LLROffset = (uint32_t)NumberOfDecoders * (2u * Context->N - 2 * LLRLength);
+
+	Workspace->LayerReferences[Row] = 1;
+	Decoder->Layers[Depth] = Layer;
+	Decoder->LLRs[Depth] = Workspace->LLRBlock + LLROffset + Layer * LLRLength;
+	Decoder->Decisions[Depth] = Workspace->DecisionBlock + Workspace->DecisionRowOffsets[Depth] + Layer * GetDecisionRowBytes(Context, Depth);
+
+	return true;
+}
+
+/// @brief Drops the decoder's reference to its layer at the given depth, the layer slot is freed when no decoder references it anymore.
+static void ReleaseLayer(PLC_Context const*const Context, DecoderData const*const Decoder, uint16_t const Depth)
+{
+	PLC_Workspace *const Workspace = Context->Workspace;
+	uint8_t const NumberOfDecoders = Context->NumberOfDecoders;
+	uint8_t const Layer = Decoder->Layers[Depth];
+
+	if(--Workspace->LayerReferences[Depth * NumberOfDecoders + Layer] == 0)
+	{
+		Workspace->FreeLayers[Depth * NumberOfDecoders + Workspace->NumberFreeLayers[Depth]++] = Layer;
+	}
+}
+
+/// @brief Makes sure the decoder is the only one referencing its layer at the given depth (-> copy on write). Has to be called before writing into a layer.
+/// Only the decisions are copied: the LLRs of a layer are only valid for the node currently processed and are always overwritten before being read.
+/// @return True on success, false if no layer slot is available (-> critical error).
+static bool MakeLayerWritable(PLC_Context const*const Context, DecoderData *const Decoder, uint16_t const Depth)
+{
+	PLC_Workspace *const Workspace = Context->Workspace;
+	if(Workspace->LayerReferences[Depth * Context->NumberOfDecoders + Decoder->Layers[Depth]] <= 1) return true;
+
+	Decision_t const*const SharedDecisions = Decoder->Decisions[Depth];
+	ReleaseLayer(Context, Decoder, Depth); // still referenced by at least one other decoder -> remains valid
+	if(!AssignNewLayer(Context, Decoder, Depth)) return false;
+
+	uint32_t const RowBytes = GetDecisionRowBytes(Context, Depth);
+	memcpy(Decoder->Decisions[Depth], SharedDecisions, RowBytes * sizeof(Decision_t));
+	STATS_ADD(Context, BytesCopied, RowBytes * sizeof(Decision_t));
+	return true;
+}
+
+/// @brief Takes an unused decoder from the workspace pool and assigns a new (unshared) layer at every depth.
+/// @return Decoder, nullptr if all decoders are in use.
+static DecoderData* CreateDecoder(PLC_Context const*const Context)
+{
+	PLC_Workspace *const Workspace = Context->Workspace;
+	if(Workspace->NumberFreeDecoders == 0) return 0;
+
+	DecoderData* Data = Workspace->FreeDecoders[--Workspace->NumberFreeDecoders];
+	Data->PathMetrics = 0;
+	Data->CRC = 0;
+
+	for(uint16_t i = 0; i < Context->n + 1; i++)
+	{
+		if(!AssignNewLayer(Context, Data, i)) return 0;
+		memset(Data->Decisions[i], 0, GetDecisionRowBytes(Context, i) * sizeof(Decision_t));
+	}
+
+	return Data;
+}
+
+/// @brief Returns a decoder to the workspace pool and releases its layer references.
+static void DeleteDecoder(PLC_Context const*const Context, DecoderData* Data)
+{
+	if(Data == 0) return;
+
+	for(uint16_t i = 0; i < Context->n + 1; i++)
+	{
+		ReleaseLayer(Context, Data, i);
+	}
+
+	PLC_Workspace *const Workspace = Context->Workspace;
+	Workspace->FreeDecoders[Workspace->NumberFreeDecoders++] = Data;
+}
+
+/// @brief Takes an unused decoder from the workspace pool, which shares all layers with the given decoder (-> lazy copy, layers are copied on write).
+static DecoderData* CopyDecoder(PLC_Context const*const Context, DecoderData const*const Dec1)
+{
+	if(Dec1 == 0) return 0;
+	PLC_Workspace *const Workspace = Context->Workspace;
+	uint16_t const n = Context->n;
+
+	if(Workspace->NumberFreeDecoders == 0) return 0;
+	DecoderData* Dec2 = Workspace->FreeDecoders[--Workspace->NumberFreeDecoders];
+
+	Dec2->PathMetrics = Dec1->PathMetrics;
+	Dec2->CRC = Dec1->CRC;
+	Dec2->Parity = Dec1->Parity;
+	memcpy(Dec2->NodeBits, Dec1->NodeBits, Context->NumberOfDecoders * sizeof(uint32_t));
+	memcpy(Dec2->NodeLLRs, Dec1->NodeLLRs, Context->NumberOfDecoders * sizeof(BPSK_t));
+	STATS_ADD(Context, PathForks, 1);
+	STATS_ADD(Context, BytesCopied, Context->NumberOfDecoders * (sizeof(uint32_t) + sizeof(BPSK_t)));
+	for(uint16_t i = 0; i < n + 1; i++)
+	{
+		Dec2->Layers[i] = Dec1->Layers[i];
+		Dec2->LLRs[i] = Dec1->LLRs[i];
+		Dec2->Decisions[i] = Dec1->Decisions[i];
+		Workspace->LayerReferences[i * Context->NumberOfDecoders + Dec1->Layers[i]]++;
+	}
+
+	return Dec2;
+}
+
+/// @brief Gets a LLR (Log Likelihood Ratio) from the specified decoder, at depth and (node) index.
+static BPSK_t GetLLR(DecoderData const*const Decoder, uint16_t const Depth, uint32_t const Index)
+{
+	if(Decoder == 0 || Decoder->LLRs == 0) return 0;
+
+	return Decoder->LLRs[Depth][Index];
+}
+
+/// @brief Sets a decoders decision at a given depth and index.
+/// @return False if the layer could not be made writable (-> critical error).
+static bool SetDecision(PLC_Context const*const Context, DecoderData *const Decoder, uint16_t const Depth, uint32_t const Index, Decision_t const Decision)
+{
+	if(Decoder == 0 || Decoder->Decisions == 0) return false;
+	if(!MakeLayerWritable(Context, Decoder, Depth)) return false;
+
+	SetBitAtIndex(Decoder->Decisions[Depth], Index, Decision);
+	return true;
+}
+
+/// @brief Magnitude of a LLR, as path metric (-> no saturation needed).
+static PathMetric_t GetMagnitude(BPSK_t const LLR)
+{
+	#ifdef PLC_LLR_FLOAT
+		return fabsf(LLR);
+	#else
+		return LLR < 0 ? -(PathMetric_t)LLR : LLR;
+	#endif
+}
+
+/// @brief Sum of two (non-negative) path metrics, saturating.
+static PathMetric_t AddMetrics(PathMetric_t const a, PathMetric_t const b)
+{
+	#ifdef PLC_LLR_FLOAT
+		return a + b;
+	#else
+		return b > PathMetric_Max - a ? PathMetric_Max : a + b;
+	#endif
+}
+
+/// @brief Adds additional metric to decoder's path metric
+static void AddPathMetric(DecoderData *const Decoder, PathMetric_t const Metric)
+{
+	if(Decoder == 0) return;
+
+	Decoder->PathMetrics = AddMetrics(Decoder->PathMetrics, Metric);
+}
+
+/// @brief Subtracts the lowest path metric of the list from all decoders (-> the metrics stay small, the order is unchanged).
+static void NormalizePathMetrics(PLC_Context const*const Context, uint8_t const CurrentDecoders)
+{
+	DecoderData *const*const Decoders = Context->Workspace->Decoders;
+	if(CurrentDecoders == 0) return;
+
+	PathMetric_t Minimum = Decoders[0]->PathMetrics;
+	for(uint8_t i = 1; i < CurrentDecoders; i++)
+	{
+		if(Decoders[i]->PathMetrics < Minimum) Minimum = Decoders[i]->PathMetrics;
+	}
+	for(uint8_t i = 0; i < CurrentDecoders; i++)
+	{
+		Decoders[i]->PathMetrics -= Minimum;
+	}
+}
+
+/// @brief Selection key of a candidate: path metric (order preserving as unsigned) in the upper half, candidate index in the lower half.
+/// Keys are unique -> ties are broken by candidate index, the same order a stable sort by path metric yields.
+static uint64_t GetSelectionKey(PathMetric_t const PathMetric, uint16_t const CandidateIndex)
+{
+	#ifdef PLC_LLR_FLOAT
+		uint32_t Bits;
+		memcpy(&Bits, &PathMetric, sizeof(Bits)); // path metrics are >= 0 -> bit patterns have the same order
+	#else
+		uint32_t const Bits = (uint32_t)PathMetric ^ 0x80000000u;
+	#endif
+	return ((uint64_t)Bits << 32) | CandidateIndex;
+}
+
+/// @brief Bitonic sorting network (ascending), branchless compare and exchange. Length has to be a power of 2.
+static void SortNetwork(uint64_t *const Keys, uint16_t const Length)
+{
+	for(uint16_t k = 2; k <= Length; k *= 2)
+	{
+		for(uint16_t j = k / 2; j > 0; j /= 2)
+		{
+			for(uint16_t i = 0; i < Length; i++)
+			{
+				uint16_t const l = i ^ j;
+				if(l <= i) continue; // data independent -> fixed network
+
+				uint64_t const a = Keys[i], b = Keys[l];
+				uint64_t const Low = a < b ? a : b;
+				uint64_t const High = a ^ b ^ Low;
+				bool const Ascending = (i & k) == 0;
+				Keys[i] = Ascending ? Low : High;
+				Keys[l] = Ascending ? High : Low;
+			}
+		}
+	}
+}
+
+/// @brief Quickselect: moves the Rank-th smallest key (0 based) to Keys[Rank], smaller keys before, larger keys behind it.
+static void QuickSelect(uint64_t *const Keys, uint16_t const Length, uint16_t const Rank)
+{
+	uint16_t Left = 0, Right = Length - 1;
+	while(Left < Right)
+	{
+		//median of three as pivot
+		uint16_t const Middle = Left + (Right - Left) / 2;
+		uint64_t a = Keys[Left], b = Keys[Middle], c = Keys[Right];
+		uint64_t const Pivot = a < b ? (b < c ? b : (a < c ? c : a)) : (a < c ? a : (b < c ? c : b));
+
+		//Hoare partition (keys are unique)
+		uint16_t i = Left, j = Right;
+		while(i <= j)
+		{
+			while(Keys[i] < Pivot) i++;
+			while(Keys[j] > Pivot) j--;
+			if(i <= j)
+			{
+				uint64_t const Temp = Keys[i]; Keys[i] = Keys[j]; Keys[j] = Temp;
+				i++;
+				if(j == 0) break;
+				j--;
+			}
+		}
+
+		if(Rank <= j) Right = j;
+		else if(Rank >= i) Left = i;
+		else return;
+	}
+}
+
+/// @brief Returns the Count-th smallest of the given keys (-> every key <= the returned one is among the Count smallest). Keys are reordered.
+/// Sorting network for short lists, quickselect otherwise.
+static uint64_t SelectThreshold(uint64_t *const Keys, uint16_t const Length, uint16_t const Count)
+{
+	if(Length <= SelectionNetworkMaxLength)
+	{
+		uint16_t NetworkLength = 1;
+		while(NetworkLength < Length) NetworkLength *= 2;
+		for(uint16_t i = Length; i < NetworkLength; i++) Keys[i] = UINT64_MAX; // padding
+
+		SortNetwork(Keys, NetworkLength);
+	}
+	else
+	{
+		QuickSelect(Keys, Length, Count - 1);
+	}
+
+	return Keys[Count - 1];
+}
+
+// --- DECODE --- //
+
+/// @brief Updates the CRC registers of all decoders with their decisions of the information bits within the given leaf range and checks them at every checkpoint.
+/// Decoders failing a check are dropped, the remaining decoders are moved to the front of the list.
+/// @return Number of remaining decoders (0 -> all decoders failed a check).
+static uint8_t CheckCRC(PLC_Context const*const Context, uint8_t CurrentDecoders, uint8_t const *const FrozenBitMask, uint32_t const FirstLeaf, uint32_t const NumberOfLeaves,
+						uint32_t *const InfoBitIndex, uint8_t *const Checkpoint, uint16_t const *const CRCValues)
+{
+	PLC_CRCConfig const*const CRC = &Context->CRC;
+	DecoderData **const Decoders = Context->Workspace->Decoders;
+
+	for(uint32_t Leaf = FirstLeaf; Leaf < FirstLeaf + NumberOfLeaves && CurrentDecoders > 0; Leaf++)
+	{
+		if(!GetBitAtIndex(FrozenBitMask, Leaf)) continue; // frozen bits are not covered by the CRC
+
+		for(uint8_t i = 0; i < CurrentDecoders; i++)
+		{
+			Decoders[i]->CRC = UpdateCRC(CRC, Decoders[i]->CRC, GetBitAtIndex(Decoders[i]->Decisions[Context->n], Leaf));
+		}
+
+		if(*Checkpoint < CRC->NumberOfCheckpoints && *InfoBitIndex == CRC->Checkpoints[*Checkpoint])
+		{
+			uint8_t RemainingDecoders = 0;
+			for(uint8_t i = 0; i < CurrentDecoders; i++)
+			{
+				if(Decoders[i]->CRC == CRCValues[*Checkpoint])
+				{
+					Decoders[i]->CRC = 0;
+					Decoders[RemainingDecoders++] = Decoders[i];
+				}
+				else
+				{
+					DeleteDecoder(Context, Decoders[i]);
+					STATS_ADD(Context, PathKills, 1);
+				}
+			}
+			for(uint8_t i = RemainingDecoders; i < CurrentDecoders; i++)
+			{
+				Decoders[i] = 0;
+			}
+
+			CurrentDecoders = RemainingDecoders;
+			(*Checkpoint)++;
+		}
+		(*InfoBitIndex)++;
+	}
+
+	return CurrentDecoders;
+}
+
+/// @brief List update: every decoder i is forked into the two candidates DecoderDecisions[i] and DecoderDecisions[i + CurrentDecoders]
+/// (decision bit at the given depth and the candidate's index + path metric), which have to be filled beforehand.
+/// Only the ListSize candidates with the lowest path metric survive (ties -> lower candidate index), selection is skipped while the list is not full.
+/// A decoder with both candidates surviving keeps the better one, the other one is taken by a copy. Copies are placed in the lowest free list positions, worst candidate first.
+/// @param ListSize List size of this decoding pass (<= NumberOfDecoders, see DecodeAndDeriveKey).
+/// @return Number of decoders after the update, 0 on critical error.
+static uint8_t ForkDecoders(PLC_Context const*const Context, uint8_t const ListSize, uint8_t CurrentDecoders, uint16_t const Depth)
+{
+	PLC_Workspace *const Workspace = Context->Workspace;
+
+	DecoderData **const Decoders = Workspace->Decoders;
+	DecoderDecision const*const DecoderDecisions = Workspace->DecoderDecisions;
+	uint64_t *const Keys = Workspace->SelectionKeys;
+	uint64_t *const Copies = Workspace->SelectionCopies;
+
+	uint8_t const Candidates = CurrentDecoders;
+	uint16_t const NumberOfCandidates = 2 * Candidates;
+
+	//survivors: every candidate with a key <= threshold
+	uint64_t Threshold = UINT64_MAX;
+	if(NumberOfCandidates > ListSize)
+	{
+		for(uint16_t i = 0; i < NumberOfCandidates; i++) Keys[i] = GetSelectionKey(DecoderDecisions[i].PathMetric, i);
+		Threshold = SelectThreshold(Keys, NumberOfCandidates, ListSize);
+		STATS_ADD(Context, Sorts, 1);
+	}
+
+	uint8_t NumberOfCopies = 0;
+	for(uint8_t i = 0; i < Candidates; i++)
+	{
+		uint64_t const Key = GetSelectionKey(DecoderDecisions[i].PathMetric, i);
+		uint64_t const InverseKey = GetSelectionKey(DecoderDecisions[i + Candidates].PathMetric, i + Candidates);
+		bool const Keep = Key <= Threshold;
+		bool const KeepInverse = InverseKey <= Threshold;
+
+		if(!Keep && !KeepInverse) //all instances of this decoder are outside of viable decision spectrum -> free up space
+		{
+			DeleteDecoder(Context, Decoders[i]);
+			STATS_ADD(Context, PathKills, 1);
+			Decoders[i] = 0;
+			CurrentDecoders--;
+			continue;
+		}
+
+		//the better surviving candidate is assigned to the decoder itself
+		DecoderDecision const*const Assigned = &DecoderDecisions[Keep && (!KeepInverse || Key < InverseKey) ? i : i + Candidates];
+		if(!SetDecision(Context, Decoders[i], Depth, Assigned->Index, Assigned->Decision)) return 0; // critical error!!!!!
+		Decoders[i]->PathMetrics = Assigned->PathMetric;
+
+		if(Keep && KeepInverse) // both instances of this decoder are inside the viable decision spectrum -> the worse one is copied (sorted descending)
+		{
+			uint64_t const CopyKey = Key < InverseKey ? InverseKey : Key;
+			uint8_t j = NumberOfCopies++;
+			for(; j > 0 && Copies[j - 1] < CopyKey; j--) Copies[j] = Copies[j - 1];
+			Copies[j] = CopyKey;
+		}
+	}
+
+	uint8_t FreeDecoderPosition = 0;
+	for(uint8_t c = 0; c < NumberOfCopies; c++)
+	{
+		uint16_t const CandidateIndex = Copies[c] & 0xFFFF;
+		uint8_t const CurrentDecoderId = CandidateIndex < Candidates ? CandidateIndex : CandidateIndex - Candidates;
+
+		//copy and assign values
+		DecoderData* CopiedDecoder = CopyDecoder(Context, Decoders[CurrentDecoderId]);
+		if(CopiedDecoder == 0) return 0; // critical error!!!!!
+
+		if(!SetDecision(Context, CopiedDecoder, Depth, DecoderDecisions[CandidateIndex].Index, DecoderDecisions[CandidateIndex].Decision)) return 0; // critical error!!!!!
+		CopiedDecoder->PathMetrics = DecoderDecisions[CandidateIndex].PathMetric;
+
+		//find free position
+		while(FreeDecoderPosition < ListSize && Decoders[FreeDecoderPosition] != 0) FreeDecoderPosition++;
+		if(FreeDecoderPosition >= ListSize) return 0; // critical error!!!!!
+
+		//add to decoders
+		Decoders[FreeDecoderPosition] = CopiedDecoder;
+		CurrentDecoders++;
+	}
+
+	if(CurrentDecoders > ListSize) return 0; // critical error!!!!!
+
+	NormalizePathMetrics(Context, CurrentDecoders);
+	return CurrentDecoders;
+}
+
+// --- DECODE - Fast-SSC nodes --- //
+
+/// @brief Classifies all nodes of the decoding tree by the frozen bit mask (-> Workspace->NodeTypes).
+static void ClassifyNodes(PLC_Context const*const Context, uint8_t const *const FrozenBitMask)
+{
+	NodeType *const NodeTypes = Context->Workspace->NodeTypes;
+	uint32_t const N = Context->N;
+
+	//leaves: frozen bit -> Rate-0, information bit -> Rate-1
+	for(uint32_t i = 0; i < N; i++)
+	{
+		NodeTypes[N - 1 + i] = GetBitAtIndex(FrozenBitMask, i) ? NT_Rate1 : NT_Rate0;
+	}
+
+	//interior nodes from their children (bottom up)
+	for(int Depth = Context->n - 1; Depth >= 0; Depth--)
+	{
+		uint32_t const Size = N >> Depth;
+		for(uint32_t Position = (1u << Depth) - 1; Position < (2u << Depth) - 1; Position++)
+		{
+			NodeType const Left = NodeTypes[2 * Position + 1];
+			NodeType const Right = NodeTypes[2 * Position + 2];
+
+			if(Left == NT_Rate0 && Right == NT_Rate0) NodeTypes[Position] = NT_Rate0;
+			else if(Left == NT_Rate1 && Right == NT_Rate1) NodeTypes[Position] = NT_Rate1;
+			else if(Left == NT_Rate0 && (Right == NT_REP || (Right == NT_Rate1 && Size == 2))) NodeTypes[Position] = NT_REP;
+			else if((Left == NT_SPC || (Left == NT_REP && Size == 4)) && Right == NT_Rate1) NodeTypes[Position] = NT_SPC;
+			else NodeTypes[Position] = NT_Generic;
+		}
+	}
+}
+
+/// @brief Gets the type of a node, generic if the node's specialization is not enabled (FastNodes: PLC_FastNode_... flags).
+static NodeType GetNodeType(PLC_Context const*const Context, uint8_t const FastNodes, uint16_t const Depth, uint32_t const Node)
+{
+	NodeType const Type = Context->Workspace->NodeTypes[(1u << Depth) + Node - 1];
+	if(Type == NT_Generic || (FastNodes & (1u << (Type - 1))) == 0) return NT_Generic;
+
+	return Type;
+}
+
+/// @brief Sets a range of decision bits to the given value.
+static void SetDecisionRange(Decision_t *const Decisions, uint32_t const StartIndex, uint32_t const Length, Decision_t const Decision)
+{
+	if(StartIndex % 8 == 0 && Length % 8 == 0) // -> whole bytes
+	{
+		memset(Decisions + StartIndex / 8, Decision ? 0xFF : 0x00, Length / 8);
+		return;
+	}
+
+	for(uint32_t i = 0; i < Length; i++)
+	{
+		SetBitAtIndex(Decisions, StartIndex + i, Decision);
+	}
+}
+
+/// @brief Sets the decisions of a node (at the node's depth) to the hard decisions of its LLRs.
+static void SetHardDecisions(Decision_t *const Decisions, uint32_t const StartIndex, BPSK_t const*const LLRs, uint32_t const Size)
+{
+	for(uint32_t i = 0; i < Size; i++)
+	{
+		SetBitAtIndex(Decisions, StartIndex + i, LLRs[i] < 0 ? 1 : 0);
+	}
+}
+
+/// @brief Finds the positions of the Count least reliable LLRs (lowest magnitude first, lower position first on ties).
+static void FindLeastReliable(BPSK_t const*const LLRs, uint32_t const Size, uint32_t *const Positions, uint16_t const Count)
+{
+	if(Count == 0) return;
+
+	uint16_t Found = 0;
+	for(uint32_t i = 0; i < Size; i++)
+	{
+		PathMetric_t const Magnitude = GetMagnitude(LLRs[i]);
+		if(Found == Count && Magnitude >= GetMagnitude(LLRs[Positions[Count - 1]])) continue;
+
+		//insertion into the sorted positions
+		uint16_t j = Found < Count ? Found++ : Count - 1;
+		for(; j > 0 && Magnitude < GetMagnitude(LLRs[Positions[j - 1]]); j--)
+		{
+			Positions[j] = Positions[j - 1];
+		}
+		Positions[j] = i;
+	}
+}
+
+/// @brief Computes the plain text bits (depth n) of a node from its decisions at the node's depth (the polar transform is its own inverse -> u = encode(beta)).
+/// @return False if the layer could not be made writable (-> critical error).
+static bool SetPlainTextFromNode(PLC_Context const*const Context, DecoderData *const Decoder, uint16_t const Depth, uint32_t const Node, uint32_t const Size)
+{
+	uint16_t const n = Context->n;
+	if(!MakeLayerWritable(Context, Decoder, n)) return false;
+
+	Decision_t *const PlainText = Decoder->Decisions[n];
+	uint32_t const StartIndex = (uint32_t)Node * Size;
+	Decision_t const*const Beta = Decoder->Decisions[Depth];
+	uint32_t const BetaIndex = GetDecisionIndex(Context, Depth, StartIndex, Size);
+
+	if(Size >= 8) // -> node is byte aligned
+	{
+		memcpy(PlainText + StartIndex / 8, Beta + BetaIndex / 8, Size / 8);
+		EncodeInPlace(PlainText + StartIndex / 8, Size);
+		return true;
+	}
+
+	uint8_t Bits[8];
+	for(uint32_t i = 0; i < Size; i++) Bits[i] = GetBitAtIndex(Beta, BetaIndex + i);
+	for(uint32_t m = 1; m < Size; m *= 2)
+	{
+		for(uint32_t i = 0; i < Size; i += 2 * m)
+		{
+			for(uint32_t j = 0; j < m; j++) Bits[i + j] ^= Bits[i + j + m];
+		}
+	}
+	for(uint32_t i = 0; i < Size; i++) SetBitAtIndex(PlainText, StartIndex + i, Bits[i]);
+	return true;
+}
+
+/// @brief Rate-0 node: all bits are frozen (-> 0). The plain text row starts zeroed, the node's decisions are reset (the row is shared with its sibling and previous nodes of this depth).
+/// @return Number of decoders, 0 on critical error.
+static uint8_t DecodeRate0Node(PLC_Context const*const Context, uint8_t const CurrentDecoders, uint16_t const Depth, uint32_t const Node, uint32_t const Size)
+{
+	DecoderData *const*const Decoders = Context->Workspace->Decoders;
+	uint32_t const DecisionIndex = GetDecisionIndex(Context, Depth, (uint32_t)Node * Size, Size);
+
+	for(uint8_t i = 0; i < CurrentDecoders; i++)
+	{
+		BPSK_t const*const LLRs = Decoders[i]->LLRs[Depth];
+
+		PathMetric_t Metric = 0;
+		for(uint32_t j = 0; j < Size; j++)
+		{
+			if(LLRs[j] < 0) Metric = AddMetrics(Metric, GetMagnitude(LLRs[j]));
+		}
+		AddPathMetric(Decoders[i], Metric);
+
+		if(!MakeLayerWritable(Context, Decoders[i], Depth)) return 0; // critical error!!!!!
+		SetDecisionRange(Decoders[i]->Decisions[Depth], DecisionIndex, Size, 0);
+	}
+
+	return CurrentDecoders;
+}
+
+/// @brief Repetition node: all bits are equal to the last plain text bit -> each decoder forks into the all zero and the all one candidate.
+/// @return Number of decoders after the update, 0 on critical error.
+static uint8_t DecodeREPNode(PLC_Context const*const Context, uint8_t const ListSize, uint8_t CurrentDecoders, uint16_t const Depth, uint32_t const Node, uint32_t const Size)
+{
+	DecoderData **const Decoders = Context->Workspace->Decoders;
+	DecoderDecision *const DecoderDecisions = Context->Workspace->DecoderDecisions;
+	uint32_t const LastLeaf = Node * Size + Size - 1;
+	uint32_t const DecisionIndex = GetDecisionIndex(Context, Depth, (uint32_t)Node * Size, Size);
+
+	for(uint8_t i = 0; i < CurrentDecoders; i++)
+	{
+		BPSK_t const*const LLRs = Decoders[i]->LLRs[Depth];
+
+		PathMetric_t MetricZero = 0, MetricOne = 0;
+		for(uint32_t j = 0; j < Size; j++)
+		{
+			if(LLRs[j] < 0) MetricZero = AddMetrics(MetricZero, GetMagnitude(LLRs[j]));
+			else MetricOne = AddMetrics(MetricOne, GetMagnitude(LLRs[j]));
+		}
+
+		Decision_t const Decision = MetricOne < MetricZero ? 1 : 0;
+		DecoderDecisions[i].Decision = Decision;
+		DecoderDecisions[i].DecoderId = i;
+		DecoderDecisions[i].Index = LastLeaf;
+		DecoderDecisions[i].PathMetric = AddMetrics(Decoders[i]->PathMetrics, Decision ? MetricOne : MetricZero);
+
+		DecoderDecisions[i + CurrentDecoders].Decision = !Decision;
+		DecoderDecisions[i + CurrentDecoders].DecoderId = i;
+		DecoderDecisions[i + CurrentDecoders].Index = LastLeaf;
+		DecoderDecisions[i + CurrentDecoders].PathMetric = AddMetrics(Decoders[i]->PathMetrics, Decision ? MetricZero : MetricOne);
+	}
+
+	CurrentDecoders = ForkDecoders(Context, ListSize, CurrentDecoders, Context->n);
+
+	//decisions at the node's depth: repeated plain text bit
+	for(uint8_t i = 0; i < CurrentDecoders; i++)
+	{
+		if(!MakeLayerWritable(Context, Decoders[i], Depth)) return 0; // critical error!!!!!
+
+		SetDecisionRange(Decoders[i]->Decisions[Depth], DecisionIndex, Size, GetBitAtIndex(Decoders[i]->Decisions[Context->n], LastLeaf));
+	}
+
+	return CurrentDecoders;
+}
+
+/// @brief Rate-1 / single parity check node: hard decisions, the list forks on the least reliable bits only (Rate-1: min(L - 1, size), SPC: min(L, size)).
+/// SPC: the parity is fixed by the least reliable bit, flipping another bit therefore costs its own LLR magnitude +- the least reliable one.
+/// The LLRs needed are cached per decoder beforehand: forking copies the node's layer on write, which does not preserve the LLR row.
+/// @return Number of decoders after the update, 0 on critical error.
+static uint8_t DecodeRate1OrSPCNode(PLC_Context const*const Context, uint8_t const ListSize, uint8_t CurrentDecoders, bool const IsSPC, uint16_t const Depth, uint32_t const Node, uint32_t const Size)
+{
+	DecoderData **const Decoders = Context->Workspace->Decoders;
+	DecoderDecision *const DecoderDecisions = Context->Workspace->DecoderDecisions;
+	uint32_t const DecisionIndex = GetDecisionIndex(Context, Depth, (uint32_t)Node * Size, Size);
+
+	uint16_t const Forks = IsSPC ? (ListSize < Size ? ListSize : Size) : (ListSize - 1u < Size ? ListSize - 1u : Size);
+
+	for(uint8_t i = 0; i < CurrentDecoders; i++)
+	{
+		BPSK_t const*const LLRs = Decoders[i]->LLRs[Depth];
+		if(!MakeLayerWritable(Context, Decoders[i], Depth)) return 0; // critical error!!!!!
+
+		SetHardDecisions(Decoders[i]->Decisions[Depth], DecisionIndex, LLRs, Size);
+		FindLeastReliable(LLRs, Size, Decoders[i]->NodeBits, Forks);
+		for(uint16_t Fork = 0; Fork < Forks; Fork++) Decoders[i]->NodeLLRs[Fork] = LLRs[Decoders[i]->NodeBits[Fork]];
+
+		if(IsSPC)
+		{
+			Decoders[i]->Parity = 0;
+			for(uint32_t j = 0; j < Size; j++) Decoders[i]->Parity ^= LLRs[j] < 0 ? 1 : 0;
+			if(Decoders[i]->Parity) AddPathMetric(Decoders[i], GetMagnitude(Decoders[i]->NodeLLRs[0]));
+		}
+	}
+
+	//SPC: the least reliable bit is reserved for the parity
+	for(uint16_t Fork = IsSPC ? 1 : 0; Fork < Forks; Fork++)
+	{
+		for(uint8_t i = 0; i < CurrentDecoders; i++)
+		{
+			uint32_t const Position = Decoders[i]->NodeBits[Fork];
+			BPSK_t const LLR = Decoders[i]->NodeLLRs[Fork];
+
+			PathMetric_t FlipMetric = GetMagnitude(LLR);
+			if(IsSPC) FlipMetric = Decoders[i]->Parity ? FlipMetric - GetMagnitude(Decoders[i]->NodeLLRs[0]) : AddMetrics(FlipMetric, GetMagnitude(Decoders[i]->NodeLLRs[0])); // NodeLLRs[0] is the least reliable -> >= 0
+
+			Decision_t const Decision = LLR < 0 ? 1 : 0;
+			DecoderDecisions[i].Decision = Decision;
+			DecoderDecisions[i].DecoderId = i;
+			DecoderDecisions[i].Index = DecisionIndex + Position;
+			DecoderDecisions[i].PathMetric = Decoders[i]->PathMetrics;
+
+			DecoderDecisions[i + CurrentDecoders].Decision = !Decision;
+			DecoderDecisions[i + CurrentDecoders].DecoderId = i;
+			DecoderDecisions[i + CurrentDecoders].Index = DecisionIndex + Position;
+			DecoderDecisions[i + CurrentDecoders].PathMetric = AddMetrics(Decoders[i]->PathMetrics, FlipMetric);
+		}
+
+		CurrentDecoders = ForkDecoders(Context, ListSize, CurrentDecoders, Depth);
+		if(CurrentDecoders == 0) return 0;
+
+		if(IsSPC) // flipped bit -> parity changes
+		{
+			for(uint8_t i = 0; i < CurrentDecoders; i++)
+			{
+				uint32_t const Position = Decoders[i]->NodeBits[Fork];
+				Decision_t const HardDecision = Decoders[i]->NodeLLRs[Fork] < 0 ? 1 : 0;
+				Decoders[i]->Parity ^= GetBitAtIndex(Decoders[i]->Decisions[Depth], DecisionIndex + Position) ^ HardDecision;
+			}
+		}
+	}
+
+	for(uint8_t i = 0; i < CurrentDecoders; i++)
+	{
+		if(IsSPC && Decoders[i]->Parity) // fix parity with the least reliable bit
+		{
+			uint32_t const Index = DecisionIndex + Decoders[i]->NodeBits[0];
+			if(!SetDecision(Context, Decoders[i], Depth, Index, !GetBitAtIndex(Decoders[i]->Decisions[Depth], Index))) return 0; // critical error!!!!!
+		}
+
+		if(!SetPlainTextFromNode(Context, Decoders[i], Depth, Node, Size)) return 0; // critical error!!!!!
+	}
+
+	return CurrentDecoders;
+}
+
+/// @brief Decodes a specialized node in closed form: decisions at the node's depth (-> for the parent) and at depth n (-> plain text).
+/// @return Number of decoders after the update, 0 on critical error.
+static uint8_t DecodeFastNode(PLC_Context const*const Context, uint8_t const ListSize, uint8_t const CurrentDecoders, NodeType const Type, uint16_t const Depth, uint32_t const Node)
+{
+	uint32_t const Size = Context->N >> Depth;
+
+	switch(Type)
+	{
+	case NT_Rate0: return DecodeRate0Node(Context, CurrentDecoders, Depth, Node, Size);
+	case NT_REP: return DecodeREPNode(Context, ListSize, CurrentDecoders, Depth, Node, Size);
+	case NT_Rate1: return DecodeRate1OrSPCNode(Context, ListSize, CurrentDecoders, false, Depth, Node, Size);
+	case NT_SPC: return DecodeRate1OrSPCNode(Context, ListSize, CurrentDecoders, true, Depth, Node, Size);
+	default: return 0;
+	}
+}
+
+// --- DECODE - plan --- //
+
+/// @brief Appends an instruction to the plan.
+static void AddInstruction(PLC_Plan *const Plan, uint8_t const Operation, uint16_t const Depth, NodeType const Type, uint32_t const Length, uint32_t const Offset)
+{
+	PlanInstruction *const Instruction = &Plan->Instructions[Plan->NumberOfInstructions++];
+	Instruction->Operation = Operation;
+	Instruction->Depth = (uint8_t)Depth;
+	Instruction->Type = Type;
+	Instruction->Length = Length;
+	Instruction->Offset = Offset;
+}
+
+/// @brief Compiles the traversal of a node (and its subtree) into the plan: f -> left subtree -> g -> right subtree -> combine.
+/// Nodes on the rightmost path (range ends at N) skip the combine, unless the plan has to provide the code word: their decisions are never read (the plain text is taken from the leaves).
+static void CompileNode(PLC_Context const*const Context, PLC_Plan *const Plan, uint16_t const Depth, uint32_t const Node)
+{
+	uint32_t const Size = Context->N >> Depth;
+
+	if(Depth == Context->n) // -> leaf node
+	{
+		AddInstruction(Plan, GetBitAtIndex(Plan->FrozenBitMask, Node) ? PO_InfoLeaf : PO_FrozenLeaf, Depth, NT_Generic, 1, Node);
+		return;
+	}
+
+	NodeType const Type = Plan->FastNodes != 0 ? GetNodeType(Context, Plan->FastNodes, Depth, Node) : NT_Generic;
+	if(Type != NT_Generic)
+	{
+		AddInstruction(Plan, PO_FastNode, Depth, Type, Size, (uint32_t)Node * Size);
+		return;
+	}
+
+	AddInstruction(Plan, PO_F, Depth, NT_Generic, Size / 2, (uint32_t)Node * Size);
+	CompileNode(Context, Plan, Depth + 1, 2 * Node);
+	AddInstruction(Plan, PO_G, Depth, NT_Generic, Size / 2, (uint32_t)Node * Size);
+	CompileNode(Context, Plan, Depth + 1, 2 * Node + 1);
+	if(Plan->CodeWord || (uint32_t)(Node + 1) * Size < Context->N) AddInstruction(Plan, PO_Combine, Depth, NT_Generic, Size / 2, (uint32_t)Node * Size);
+}
+
+/// @brief Compiles the decoding plan for a frozen bit mask.
+/// @param FastNodes Node specializations to use (PLC_FastNode_... flags).
+/// @param CodeWord Combine up to the root (-> the depth 0 decision row holds the code word estimate after decoding).
+/// @return New plan, nullptr on error.
+static PLC_Plan* CompilePlan(PLC_Context const*const Context, uint8_t const *const FrozenBitMask, uint8_t const FastNodes, bool const CodeWord)
+{
+	uint32_t const N = Context->N;
+
+	PLC_Plan* Plan = calloc(1, sizeof(PLC_Plan));
+	if(Plan == 0) return 0;
+
+	//at most f, g and combine per interior node + one instruction per leaf
+	Plan->FrozenBitMask = malloc(Context->NBytes);
+	Plan->Instructions = malloc((3 * (N - 1) + N) * sizeof(PlanInstruction));
+	if(Plan->FrozenBitMask == 0 || Plan->Instructions == 0)
+	{
+		DeletePlan(Plan);
+		return 0;
+	}
+	memcpy(Plan->FrozenBitMask, FrozenBitMask, Context->NBytes);
+	Plan->FastNodes = FastNodes;
+	Plan->CodeWord = CodeWord;
+
+	if(FastNodes != 0) ClassifyNodes(Context, FrozenBitMask);
+	CompileNode(Context, Plan, 0, 0);
+
+	PlanInstruction* Instructions = realloc(Plan->Instructions, Plan->NumberOfInstructions * sizeof(PlanInstruction));
+	if(Instructions != 0) Plan->Instructions = Instructions;
+	STATS_ADD(Context, Allocations, 4);
+
+	return Plan;
+}
+
+/// @brief Returns the cached plan for the frozen bit mask and node specializations, compiles (and caches) it if not done yet.
+/// @param CodeWord The code word estimate is needed (-> plan with the combines of the rightmost path).
+/// @return Plan, nullptr on error.
+static PLC_Plan const* GetPlan(PLC_Context *const Context, uint8_t const *const FrozenBitMask, uint8_t const FastNodes, bool const CodeWord)
+{
+	for(uint8_t i = 0; i < PlanCacheSize; i++)
+	{
+		PLC_Plan const*const Plan = Context->Plans[i];
+		if(Plan != 0 && Plan->FastNodes == FastNodes && (Plan->CodeWord || !CodeWord) && memcmp(Plan->FrozenBitMask, FrozenBitMask, Context->NBytes) == 0) return Plan;
+	}
+
+	PLC_Plan* Plan = CompilePlan(Context, FrozenBitMask, FastNodes, CodeWord);
+	if(Plan == 0) return 0;
+
+	//replace the oldest plan
+	DeletePlan(Context->Plans[Context->NextPlan]);
+	Context->Plans[Context->NextPlan] = Plan;
+	Context->NextPlan = (Context->NextPlan + 1) % PlanCacheSize;
+
+	return Plan;
+}
+
+PLC_Plan const* PLC_GetPlan(PLC_Context *const Context, uint8_t const *const FrozenBitMask, uint32_t const FrozenBitMaskLength)
+{
+	if(Context == 0 || Context->Workspace == 0) return 0;
+	if(FrozenBitMask == 0 || FrozenBitMaskLength != Context->NBytes) return 0;
+
+	return GetPlan(Context, FrozenBitMask, Context->FastNodes, true);
+}
+
+// --- DECODE - list decoder --- //
+
+/// @brief Successive cancellation list decoding, using only the context's workspace (-> no heap allocations, once the plan for the mask is cached).
+/// The decoder input (channel LLRs) has to be placed in Workspace->ChannelLLRs beforehand.
+/// Surviving decoders are located in Workspace->Decoders[0 ... return value - 1].
+/// @param CRCValues Expected CRC value for every checkpoint of the context's CRC configuration. Nullptr -> no CRC check.
+/// @param ListSize List size (1 ... NumberOfDecoders): the workspace is sized for the context's list, a smaller list runs in the same workspace.
+/// @param CodeWord Combine up to the root -> Decisions[0] of every surviving decoder holds its code word estimate (else only Decisions[n], the plain text, is valid).
+/// @return Number of surviving decoders, 0 on error or if all decoders failed a CRC check.
+static uint8_t SCL_Decode(PLC_Context *const Context, uint8_t const ListSize, uint8_t const *const FrozenBitMask, uint16_t const *const CRCValues, bool const CodeWord)
+{
+	uint32_t const N = Context->N;
+	PLC_Workspace *const Workspace = Context->Workspace;
+	PLC_Kernels const*const Kernels = Context->Kernels;
+
+	DecoderData **const Decoders = Workspace->Decoders;
+	DecoderDecision *const DecoderDecisions = Workspace->DecoderDecisions;
+
+	STATS_ADD(Context, DecoderCalls, 1);
+	STATS_START(Lap);
+
+	PLC_Plan const*const Plan = GetPlan(Context, FrozenBitMask, Context->FastNodes, CodeWord);
+	if(Plan == 0) return 0;
+	STATS_LAP(Context, PLC_Stage_Plan, Lap);
+
+	ResetWorkspace(Context);
+
+	uint8_t CurrentDecoders = 1;
+
+	bool const UseCRC = Context->CRC.Length > 0 && CRCValues != 0;
+	uint32_t InfoBitIndex = 0;
+	uint8_t Checkpoint = 0;
+
+	//create initial decoder and add input values
+	DecoderData* InitialDecoder = CreateDecoder(Context);
+	if(InitialDecoder == 0) return 0;
+	memcpy(InitialDecoder->LLRs[0], Workspace->ChannelLLRs, N * sizeof(BPSK_t));
+	Decoders[0] = InitialDecoder; InitialDecoder = 0;
+
+	for(uint32_t Step = 0; Step < Plan->NumberOfInstructions; Step++)
+	{
+		PlanInstruction const*const Instruction = &Plan->Instructions[Step];
+		uint16_t const Depth = Instruction->Depth;
+		uint32_t const Length = Instruction->Length;
+		uint32_t const Offset = Instruction->Offset;
+
+		switch(Instruction->Operation)
+		{
+		case PO_F: // step "L" (left node)
+			for(uint8_t i = 0; i < CurrentDecoders; i++)
+			{
+				if(!MakeLayerWritable(Context, Decoders[i], Depth + 1)) return 0; // critical error!!!!!
+
+				BPSK_t const*const a = Decoders[i]->LLRs[Depth];
+				Kernels->f(Decoders[i]->LLRs[Depth + 1], a, a + Length, Length);
+			}
+			STATS_ADD(Context, FOperations, CurrentDecoders);
+			STATS_ADD(Context, FElements, (uint64_t)CurrentDecoders * Length);
+			STATS_LAP(Context, PLC_Stage_F, Lap);
+			break;
+		case PO_G: // step "R" (right node)
+			for(uint8_t i = 0; i < CurrentDecoders; i++)
+			{
+				if(!MakeLayerWritable(Context, Decoders[i], Depth + 1)) return 0; // critical error!!!!!
+
+				BPSK_t const*const a = Decoders[i]->LLRs[Depth];
+				Kernels->g(Decoders[i]->LLRs[Depth + 1], a, a + Length, Decoders[i]->Decisions[Depth + 1], GetDecisionIndex(Context, Depth + 1, Offset, Length), Length);
+			}
+			STATS_ADD(Context, GOperations, CurrentDecoders);
+			STATS_ADD(Context, GElements, (uint64_t)CurrentDecoders * Length);
+			STATS_LAP(Context, PLC_Stage_G, Lap);
+			break;
+		case PO_Combine: // step "U" (center / to parent)
+			{
+				uint32_t const NodeIndex = GetDecisionIndex(Context, Depth, Offset, 2u * Length);
+				uint32_t const LeftIndex = GetDecisionIndex(Context, Depth + 1, Offset, Length);
+				for(uint8_t i = 0; i < CurrentDecoders; i++)
+				{
+					if(!MakeLayerWritable(Context, Decoders[i], Depth)) return 0; // critical error!!!!!
+
+					Kernels->Combine(Decoders[i]->Decisions[Depth], NodeIndex, Decoders[i]->Decisions[Depth + 1], LeftIndex, LeftIndex + Length, Length);
+				}
+			}
+			STATS_ADD(Context, CombineOperations, CurrentDecoders);
+			STATS_ADD(Context, CombineElements, (uint64_t)CurrentDecoders * Length);
+			STATS_LAP(Context, PLC_Stage_Combine, Lap);
+			break;
+		case PO_FrozenLeaf:
+			for(uint8_t i = 0; i < CurrentDecoders; i++)
+			{
+				BPSK_t DecisionMetric = GetLLR(Decoders[i], Depth, 0);
+				if(!SetDecision(Context, Decoders[i], Depth, Offset, 0)) return 0; // bit is frozen -> value is set to 0 (-> "frozen") during encoding
+				if(DecisionMetric < 0) AddPathMetric(Decoders[i], GetMagnitude(DecisionMetric));
+			}
+			STATS_ADD(Context, FrozenLeaves, CurrentDecoders);
+			STATS_LAP(Context, PLC_Stage_Leaves, Lap);
+			break;
+		case PO_InfoLeaf:
+			{
+				//get both possible decisions (+path metric) for each decoder
+				for(uint8_t i = 0; i < CurrentDecoders; i++)
+				{
+					BPSK_t const DecisionMetric = GetLLR(Decoders[i], Depth, 0);
+					Decision_t const Decision = DecisionMetric < 0 ? 1 : 0;
+					Decision_t const InverseDecision = DecisionMetric >= 0 ? 1 : 0;
+
+					DecoderDecisions[i].Decision = Decision;
+					DecoderDecisions[i].DecoderId = i;
+					DecoderDecisions[i].Index = Offset;
+					DecoderDecisions[i].PathMetric = Decoders[i]->PathMetrics;
+
+					PathMetric_t const CopiedPathMetric = AddMetrics(Decoders[i]->PathMetrics, GetMagnitude(DecisionMetric));
+					DecoderDecisions[i + CurrentDecoders].Decision = InverseDecision;
+					DecoderDecisions[i + CurrentDecoders].DecoderId = i;
+					DecoderDecisions[i + CurrentDecoders].Index = Offset;
+					DecoderDecisions[i + CurrentDecoders].PathMetric = CopiedPathMetric;
+				}
+
+				STATS_ADD(Context, InfoLeaves, CurrentDecoders);
+				CurrentDecoders = ForkDecoders(Context, ListSize, CurrentDecoders, Depth);
+				if(CurrentDecoders == 0) return 0; // critical error!!!!!
+				STATS_LAP(Context, PLC_Stage_Leaves, Lap);
+
+				if(UseCRC)
+				{
+					CurrentDecoders = CheckCRC(Context, CurrentDecoders, FrozenBitMask, Offset, 1, &InfoBitIndex, &Checkpoint, CRCValues);
+					if(CurrentDecoders == 0) return 0; // all paths failed the CRC -> early exit
+					STATS_LAP(Context, PLC_Stage_CRC, Lap);
+				}
+			}
+			break;
+		case PO_FastNode: // specialized node, decoded in closed form
+			CurrentDecoders = DecodeFastNode(Context, ListSize, CurrentDecoders, Instruction->Type, Depth, Offset / Length);
+			if(CurrentDecoders == 0) return 0; // critical error!!!!!
+			STATS_LAP(Context, PLC_Stage_FastNodes, Lap);
+
+			if(UseCRC && Instruction->Type != NT_Rate0)
+			{
+				CurrentDecoders = CheckCRC(Context, CurrentDecoders, FrozenBitMask, Offset, Length, &InfoBitIndex, &Checkpoint, CRCValues);
+				if(CurrentDecoders == 0) return 0; // all paths failed the CRC -> early exit
+				STATS_LAP(Context, PLC_Stage_CRC, Lap);
+			}
+			break;
+		default: return 0;
+		}
+	}
+
+	return CurrentDecoders;
+}
+
+uint8_t **PLC_SCL_Decode(uint8_t const *const Input, uint32_t const InputLength,
+					   uint8_t const *const FrozenBitMask, uint32_t const FrozenBitMaskLength)
+{
+	return PLC_SCL_Decode_Ctx(GetDefaultContext(), Input, InputLength, FrozenBitMask, FrozenBitMaskLength);
+}
+
+/// @brief Output of a surviving decoder: its plain text, or its code word estimate (PLC_SetCodeWordOutput).
+static uint8_t const* GetOutputRow(PLC_Context const*const Context, DecoderData const*const Decoder)
+{
+	return Decoder->Decisions[Context->CodeWordOutput ? 0 : Context->n];
+}
+
+/// @brief Copies the decisions of the surviving decoders into a newly allocated output list (free it yourself!).
+/// @return List (of length NumberOfDecoders) of decoded plain texts, unused entries are nullptr.
+static uint8_t** CreateOutputList(PLC_Context const*const Context, uint8_t const CurrentDecoders)
+{
+	uint32_t const NBytes = Context->NBytes;
+	uint8_t const NumberOfDecoders = Context->NumberOfDecoders;
+
+	STATS_START(Lap);
+	uint8_t** Output = malloc(NumberOfDecoders * sizeof(uint8_t*));
+	if(Output == 0) return 0;
+
+	for(uint16_t i = 0; i < NumberOfDecoders; i++)
+	{
+		if(i < CurrentDecoders)
+		{
+			Output[i] = malloc(NBytes * sizeof(uint8_t));
+			memcpy(Output[i], GetOutputRow(Context, Context->Workspace->Decoders[i]), NBytes);
+		}
+		else
+		{
+			Output[i] = 0;
+		}
+	}
+	STATS_ADD(Context, Allocations, 1 + CurrentDecoders);
+	STATS_LAP(Context, PLC_Stage_Output, Lap);
+
+	return Output;
+}
+
+/// @brief Returns the index of the surviving decoder with the lowest path metric.
+static uint8_t GetBestDecoder(PLC_Context const*const Context, uint8_t const CurrentDecoders)
+{
+	DecoderData *const*const Decoders = Context->Workspace->Decoders;
+
+	uint8_t Best = 0;
+	for(uint8_t i = 1; i < CurrentDecoders; i++)
+	{
+		if(Decoders[i]->PathMetrics < Decoders[Best]->PathMetrics) Best = i;
+	}
+	return Best;
+}
+
+/// @brief Converts an input LLR to the LLR precision of the build (saturating).
+static BPSK_t ConvertLLR(int16_t const LLR)
+{
+	#ifdef PLC_LLR_INT8
+		return LLR > BPSK_Max ? BPSK_Max : (LLR < BPSK_Min ? BPSK_Min : (BPSK_t)LLR);
+	#else
+		return (BPSK_t)LLR;
+	#endif
+}
+
+/// @brief Places the given (hard decision) input BPSK encoded in the workspace as decoder input.
+static void SetHardInput(PLC_Context *const Context, uint8_t const *const Input)
+{
+	for(uint32_t i = 0; i < Context->N; i++)
+	{
+		Context->Workspace->ChannelLLRs[i] = ToBPSK(GetBitAtIndex(Input, i));
+	}
+}
+
+uint8_t **PLC_SCL_Decode_Ctx(PLC_Context *const Context,
+							 uint8_t const *const Input, uint32_t const InputLength,
+							 uint8_t const *const FrozenBitMask, uint32_t const FrozenBitMaskLength)
+{
+	if(Context == 0 || Context->Workspace == 0) return 0;
+	uint32_t const NBytes = Context->NBytes;
+
+	if(Input == 0 || InputLength < NBytes) return 0;
+	if(FrozenBitMask == 0 || FrozenBitMaskLength != NBytes) return 0;
+
+	SetHardInput(Context, Input);
+
+	uint8_t const CurrentDecoders = SCL_Decode(Context, Context->NumberOfDecoders, FrozenBitMask, 0, Context->CodeWordOutput);
+	if(CurrentDecoders == 0) return 0;
+
+	return CreateOutputList(Context, CurrentDecoders);
+}
+
+uint8_t **PLC_SCL_Decode_Soft(PLC_Context *const Context,
+							  int16_t const *const LLRs, uint32_t const NumberOfLLRs,
+							  uint8_t const *const FrozenBitMask, uint32_t const FrozenBitMaskLength)
+{
+	if(Context == 0 || Context->Workspace == 0) return 0;
+	uint32_t const N = Context->N;
+
+	if(LLRs == 0 || NumberOfLLRs < N) return 0;
+	if(FrozenBitMask == 0 || FrozenBitMaskLength != Context->NBytes) return 0;
+
+	for(uint32_t i = 0; i < N; i++)
+	{
+		Context->Workspace->ChannelLLRs[i] = ConvertLLR(LLRs[i]);
+	}
+
+	uint8_t const CurrentDecoders = SCL_Decode(Context, Context->NumberOfDecoders, FrozenBitMask, 0, Context->CodeWordOutput);
+	if(CurrentDecoders == 0) return 0;
+
+	return CreateOutputList(Context, CurrentDecoders);
+}
+
+uint8_t *PLC_SCL_Decode_CRC(PLC_Context *const Context,
+							uint8_t const *const Input, uint32_t const InputLength,
+							uint8_t const *const FrozenBitMask, uint32_t const FrozenBitMaskLength,
+							uint16_t const *const CRCValues, uint8_t const NumberOfCRCValues)
+{
+	if(Context == 0 || Context->Workspace == 0) return 0;
+	uint32_t const NBytes = Context->NBytes;
+
+	if(Input == 0 || InputLength < NBytes) return 0;
+	if(FrozenBitMask == 0 || FrozenBitMaskLength != NBytes) return 0;
+	if(Context->CRC.Length == 0 || CRCValues == 0 || NumberOfCRCValues != Context->CRC.NumberOfCheckpoints) return 0;
+
+	SetHardInput(Context, Input);
+
+	uint8_t const CurrentDecoders = SCL_Decode(Context, Context->NumberOfDecoders, FrozenBitMask, CRCValues, Context->CodeWordOutput);
+	if(CurrentDecoders == 0) return 0; // all paths failed the CRC (or error)
+
+	uint8_t* Winner = malloc(NBytes * sizeof(uint8_t));
+	if(Winner == 0) return 0;
+	STATS_ADD(Context, Allocations, 1);
+
+	memcpy(Winner, GetOutputRow(Context, Context->Workspace->Decoders[GetBestDecoder(Context, CurrentDecoders)]), NBytes);
+	return Winner;
+}
+
+/// @brief Packs the information bits (non-frozen positions, in index order) of a plain text (systematic code: of a code word).
+static void ExtractInfoBits(PLC_Context const*const Context, uint8_t const *const Word, uint8_t const *const FrozenBitMask, uint8_t *const InfoBits)
+{
+	memset(InfoBits, 0, (Context->K + 7) / 8);
+	for(uint32_t i = 0, InfoBitIndex = 0; i < Context->N; i++)
+	{
+		if(GetBitAtIndex(FrozenBitMask, i)) SetBitAtIndex(InfoBits, InfoBitIndex++, GetBitAtIndex(Word, i));
+	}
+}
+
+uint8_t PLC_SCL_Decode_Into(PLC_Context *const Context_,
+							uint8_t const *const Input, uint32_t const InputLength,
+							uint8_t const *const FrozenBitMask, uint32_t const FrozenBitMaskLength,
+							uint8_t *const Outputs, uint32_t const OutputsLength, PLC_PathMetric *const PathMetrics)
+{
+	PLC_Context *const Context = Context_ != 0 ? Context_ : GetDefaultContext();
+	if(Context->Workspace == 0) return 0;
+	uint32_t const NBytes = Context->NBytes;
+	uint8_t const NumberOfDecoders = Context->NumberOfDecoders;
+
+	if(Input == 0 || InputLength < NBytes) return 0;
+	if(FrozenBitMask == 0 || FrozenBitMaskLength != NBytes) return 0;
+	if(Outputs == 0 || OutputsLength < (uint32_t)NumberOfDecoders * NBytes) return 0;
+
+	SetHardInput(Context, Input);
+
+	uint8_t const CurrentDecoders = SCL_Decode(Context, Context->NumberOfDecoders, FrozenBitMask, 0, Context->CodeWordOutput);
+	if(CurrentDecoders == 0) return 0;
+
+	STATS_START(Lap);
+	for(uint8_t i = 0; i < NumberOfDecoders; i++)
+	{
+		uint8_t *const Output = Outputs + (uint32_t)i * NBytes;
+		if(i < CurrentDecoders) memcpy(Output, GetOutputRow(Context, Context->Workspace->Decoders[i]), NBytes);
+		else memset(Output, 0, NBytes);
+
+		if(PathMetrics != 0) PathMetrics[i] = i < CurrentDecoders ? Context->Workspace->Decoders[i]->PathMetrics : 0;
+	}
+	STATS_LAP(Context, PLC_Stage_Output, Lap);
+
+	return CurrentDecoders;
+}
+
+uint8_t PLC_SCL_Decode_InfoBits(PLC_Context *const Context_,
+								uint8_t const *const Input, uint32_t const InputLength,
+								uint8_t const *const FrozenBitMask, uint32_t const FrozenBitMaskLength,
+								uint8_t *const InfoBits, uint32_t const InfoBitsLength, PLC_PathMetric *const PathMetrics)
+{
+	PLC_Context *const Context = Context_ != 0 ? Context_ : GetDefaultContext();
+	if(Context->Workspace == 0) return 0;
+	uint32_t const NBytes = Context->NBytes;
+	uint32_t const InfoBytes = (Context->K + 7) / 8;
+	uint8_t const NumberOfDecoders = Context->NumberOfDecoders;
+
+	if(Input == 0 || InputLength < NBytes) return 0;
+	if(FrozenBitMask == 0 || FrozenBitMaskLength != NBytes || CountInfoBits(FrozenBitMask, NBytes) != Context->K) return 0; // K information bits per path
+	if(InfoBits == 0 || InfoBitsLength < (uint32_t)NumberOfDecoders * InfoBytes) return 0;
+
+	SetHardInput(Context, Input);
+
+	//systematic code -> information bits are taken from the code word estimates
+	uint8_t const CurrentDecoders = SCL_Decode(Context, Context->NumberOfDecoders, FrozenBitMask, 0, Context->Systematic);
+	if(CurrentDecoders == 0) return 0;
+
+	STATS_START(Lap);
+	for(uint8_t i = 0; i < NumberOfDecoders; i++)
+	{
+		uint8_t *const Output = InfoBits + (uint32_t)i * InfoBytes;
+		if(i < CurrentDecoders) ExtractInfoBits(Context, Context->Workspace->Decoders[i]->Decisions[Context->Systematic ? 0 : Context->n], FrozenBitMask, Output);
+		else memset(Output, 0, InfoBytes);
+
+		if(PathMetrics != 0) PathMetrics[i] = i < CurrentDecoders ? Context->Workspace->Decoders[i]->PathMetrics : 0;
+	}
+	STATS_LAP(Context, PLC_Stage_Output, Lap);
+
+	return CurrentDecoders;
+}
+
+// --- DECODE (batch) --- //
+
+/// @brief Scratch memory for decoding multiple frames in lockstep. All rows are frame interleaved: position j of frame b -> index j * Frames + b.
+/// Every path slot holds one path of every frame, each frame forks and prunes its paths independently.
+struct PLC_Batch
+{
+	uint16_t BatchSize;				// max. frames per call
+	uint32_t N;						// code parameters the batch was created for
+	uint8_t NumberOfDecoders;
+
+	//compact rows as in the workspace: depth d holds (N >> d) * BatchSize LLRs and, for d >= 1, 2 (N >> d) * BatchSize decisions (both children of the node at depth d - 1)
+	BPSK_t* LLRBlock;				// NumberOfDecoders * (2N - 1) * BatchSize LLRs
+	Decision_t* DecisionBlock;		// NumberOfDecoders * SlotDecisionBytes decisions (bit packed)
+	uint32_t* DecisionRowOffsets;	// n + 1 start offsets of the depths within a slot's decisions
+	uint32_t SlotDecisionBytes;
+	PathMetric_t* PathMetrics;		// BatchSize * NumberOfDecoders
+	uint8_t* NumberOfPaths;			// BatchSize, active paths occupy the slots 0 ... NumberOfPaths - 1
+	uint16_t* History;				// N * BatchSize * NumberOfDecoders: per information bit, frame and slot: slot of the path before the bit << 1 | decision
+	uint8_t* SlotUsed;				// NumberOfDecoders
+
+	DecoderDecision* DecoderDecisions; // 2 * NumberOfDecoders decision candidates
+	uint64_t* SelectionKeys;		// max(2 * NumberOfDecoders, SelectionNetworkMaxLength)
+	uint64_t* SelectionCopies;		// NumberOfDecoders
+};
+
+void PLC_DeleteBatch(PLC_Batch* Batch)
+{
+	if(Batch == 0) return;
+
+	free(Batch->LLRBlock);
+	free(Batch->DecisionBlock);
+	free(Batch->DecisionRowOffsets);
+	free(Batch->PathMetrics);
+	free(Batch->NumberOfPaths);
+	free(Batch->History);
+	free(Batch->SlotUsed);
+	free(Batch->DecoderDecisions);
+	free(Batch->SelectionKeys);
+	free(Batch->SelectionCopies);
+	free(Batch);
+}
+
+PLC_Batch* PLC_CreateBatch(PLC_Context const *const Context, uint16_t const BatchSize)
+{
+	if(Context == 0 || BatchSize == 0) return 0;
+	uint8_t const NumberOfDecoders = Context->NumberOfDecoders;
+	uint16_t const n = Context->n;
+	if((uint64_t)NumberOfDecoders * (2u * Context->N - 1) * BatchSize > UINT32_MAX) return 0; // rows of all slots are addressed with 32 bit indices
+
+	PLC_Batch* Batch = calloc(1, sizeof(PLC_Batch));
+	if(Batch == 0) return 0;
+
+	Batch->BatchSize = BatchSize;
+	Batch->N = Context->N;
+	Batch->NumberOfDecoders = NumberOfDecoders;
+
+	Batch->DecisionRowOffsets = malloc((n + 1) * sizeof(uint32_t));
+	if(Batch->DecisionRowOffsets == 0)
+	{
+		PLC_DeleteBatch(Batch);
+		return 0;
+	}
+	Batch->DecisionRowOffsets[0] = 0; // depth 0 has no decisions (the root is never combined)
+	Batch->SlotDecisionBytes = 0;
+	for(uint16_t Depth = 1; Depth < n + 1; Depth++)
+	{
+		Batch->DecisionRowOffsets[Depth] = Batch->SlotDecisionBytes;
+		Batch->SlotDecisionBytes += ((uint32_t)(Context->N >> (Depth - 1)) * BatchSize + 7) / 8;
+	}
+
+	Batch->LLRBlock = calloc((size_t)NumberOfDecoders * (2u * Context->N - 1) * BatchSize, sizeof(BPSK_t)); // zeroed: f / g run on unused path slots too (results discarded)
+	Batch->DecisionBlock = calloc((uint32_t)NumberOfDecoders * Batch->SlotDecisionBytes, sizeof(Decision_t));
+	Batch->PathMetrics = malloc(BatchSize * NumberOfDecoders * sizeof(PathMetric_t));
+	Batch->NumberOfPaths = malloc(BatchSize * sizeof(uint8_t));
+	Batch->History = malloc((size_t)Context->N * BatchSize * NumberOfDecoders * sizeof(uint16_t));
+	Batch->SlotUsed = malloc(NumberOfDecoders * sizeof(uint8_t));
+	Batch->DecoderDecisions = malloc(2 * NumberOfDecoders * sizeof(DecoderDecision));
+	Batch->SelectionKeys = malloc((2 * NumberOfDecoders > SelectionNetworkMaxLength ? 2 * NumberOfDecoders : SelectionNetworkMaxLength) * sizeof(uint64_t));
+	Batch->SelectionCopies = malloc(NumberOfDecoders * sizeof(uint64_t));
+
+	if(Batch->LLRBlock == 0 || Batch->DecisionBlock == 0 || Batch->PathMetrics == 0 || Batch->NumberOfPaths == 0 || Batch->History == 0 || Batch->SlotUsed == 0 ||
+	   Batch->DecoderDecisions == 0 || Batch->SelectionKeys == 0 || Batch->SelectionCopies == 0)
+	{
+		PLC_DeleteBatch(Batch);
+		return 0;
+	}
+
+	return Batch;
+}
+
+/// @brief Gets the LLR row of a path slot at a given depth (node currently processed at this depth).
+static BPSK_t* GetBatchLLRs(PLC_Context const*const Context, PLC_Batch const*const Batch, uint8_t const Slot, uint16_t const Depth)
+{
+	uint32_t const N = Context->N;
+	return Batch->LLRBlock + ((uint32_t)Slot * (2 * N - 1) + 2 * N - 2 * (N >> Depth)) * Batch->BatchSize;
+}
+
+/// @brief Gets the decision row of a path slot at a given depth >= 1 (both children of the node currently processed at depth - 1).
+static Decision_t* GetBatchDecisions(PLC_Batch const*const Batch, uint8_t const Slot, uint16_t const Depth)
+{
+	return Batch->DecisionBlock + (uint32_t)Slot * Batch->SlotDecisionBytes + Batch->DecisionRowOffsets[Depth];
+}
+
+/// @brief Copies the path of one frame from one slot to another. Only the parts read by the remaining traversal are copied, per ancestor of the leaf:
+/// its LLRs if the leaf is in its left subtree (-> g pending), else the decisions of its left child (-> combine pending, unless the ancestor is on the rightmost path).
+/// The plain text is not copied, it is traced back through the history at the end.
+static void CopyBatchPath(PLC_Context const*const Context, PLC_Batch const*const Batch, uint16_t const Frames, uint16_t const Frame,
+						  uint8_t const Source, uint8_t const Destination, uint32_t const Leaf)
+{
+	bool OnRightmostPath = true;
+	for(uint16_t Depth = 0; Depth < Context->n; Depth++)
+	{
+		uint32_t const Size = Context->N >> Depth;
+
+		if(Leaf % Size < Size / 2)
+		{
+			OnRightmostPath = false;
+
+			BPSK_t const*const Src = GetBatchLLRs(Context, Batch, Source, Depth) + Frame;
+			BPSK_t *const Dst = GetBatchLLRs(Context, Batch, Destination, Depth) + Frame;
+			for(uint32_t j = 0; j < Size; j++) Dst[j * Frames] = Src[j * Frames];
+			STATS_ADD(Context, BytesCopied, Size * sizeof(BPSK_t));
+		}
+		else if(!OnRightmostPath)
+		{
+			Decision_t const*const Src = GetBatchDecisions(Batch, Source, Depth + 1);
+			Decision_t *const Dst = GetBatchDecisions(Batch, Destination, Depth + 1);
+			for(uint32_t j = 0; j < Size / 2; j++)
+			{
+				uint32_t const Index = j * Frames + Frame;
+				uint8_t const Bit = 1u << (Index % 8);
+				Dst[Index / 8] = (Dst[Index / 8] & ~Bit) | (Src[Index / 8] & Bit);
+			}
+			STATS_ADD(Context, BytesCopied, (Size / 2 + 7) / 8);
+		}
+	}
+}
+
+/// @brief List update of one frame at an information bit, same selection as ForkDecoders (-> same paths in the same slots as PLC_SCL_Decode).
+/// @param InfoBitIndex Number of information bits before this one (-> history row).
+static void ForkBatchPaths(PLC_Context const*const Context, PLC_Batch *const Batch, uint16_t const Frames, uint16_t const Frame, uint32_t const Leaf, uint32_t const InfoBitIndex)
+{
+	uint8_t const NumberOfDecoders = Context->NumberOfDecoders;
+	uint16_t const n = Context->n;
+	uint32_t const Index = (Leaf & 1) * Frames + Frame; // leaf decisions: both children of the node at depth n - 1
+
+	DecoderDecision *const DecoderDecisions = Batch->DecoderDecisions;
+	PathMetric_t *const PathMetrics = Batch->PathMetrics + Frame * NumberOfDecoders;
+	uint64_t *const Keys = Batch->SelectionKeys;
+	uint64_t *const Copies = Batch->SelectionCopies;
+	uint8_t *const SlotUsed = Batch->SlotUsed;
+	uint16_t *const History = Batch->History + ((size_t)InfoBitIndex * Frames + Frame) * NumberOfDecoders;
+
+	uint8_t const Candidates = Batch->NumberOfPaths[Frame];
+	uint16_t const NumberOfCandidates = 2 * Candidates;
+	STATS_ADD(Context, InfoLeaves, Candidates);
+
+	//get both possible decisions (+path metric) for each path
+	for(uint8_t i = 0; i < Candidates; i++)
+	{
+		BPSK_t const DecisionMetric = GetBatchLLRs(Context, Batch, i, n)[Frame];
 
-				//update decoder array without unnecessary copying (-> less peak memory usage)
-				uint8_t* DecodersVisited = calloc(CurrentDecoders, sizeof(uint8_t));
-				for(int8_t i = CurrentDecoders * 2 - 1; i >= 0; i--)
+		DecoderDecisions[i].Decision = DecisionMetric < 0 ? 1 : 0;
+		DecoderDecisions[i].PathMetric = PathMetrics[i];
+		DecoderDecisions[i + Candidates].Decision = DecisionMetric >= 0 ? 1 : 0;
+		DecoderDecisions[i + Candidates].PathMetric = AddMetrics(PathMetrics[i], GetMagnitude(DecisionMetric));
+	}
+
+	uint64_t Threshold = UINT64_MAX;
+	if(NumberOfCandidates > NumberOfDecoders)
+	{
+		for(uint16_t i = 0; i < NumberOfCandidates; i++) Keys[i] = GetSelectionKey(DecoderDecisions[i].PathMetric, i);
+		Threshold = SelectThreshold(Keys, NumberOfCandidates, NumberOfDecoders);
+		STATS_ADD(Context, Sorts, 1);
+	}
+
+	memset(SlotUsed, 0, NumberOfDecoders * sizeof(uint8_t));
+	uint8_t NumberOfCopies = 0;
+	uint8_t NumberOfPaths = 0;
+	for(uint8_t i = 0; i < Candidates; i++)
+	{
+		uint64_t const Key = GetSelectionKey(DecoderDecisions[i].PathMetric, i);
+		uint64_t const InverseKey = GetSelectionKey(DecoderDecisions[i + Candidates].PathMetric, i + Candidates);
+		bool const Keep = Key <= Threshold;
+		bool const KeepInverse = InverseKey <= Threshold;
+		if(!Keep && !KeepInverse) // path is dropped -> slot is free
+		{
+			STATS_ADD(Context, PathKills, 1);
+			continue;
+		}
+
+		DecoderDecision const*const Assigned = &DecoderDecisions[Keep && (!KeepInverse || Key < InverseKey) ? i : i + Candidates];
+		SetBitAtIndex(GetBatchDecisions(Batch, i, n), Index, Assigned->Decision);
+		History[i] = (uint16_t)(i << 1) | Assigned->Decision;
+		PathMetrics[i] = Assigned->PathMetric;
+		SlotUsed[i] = 1;
+		NumberOfPaths++;
+
+		if(Keep && KeepInverse)
+		{
+			uint64_t const CopyKey = Key < InverseKey ? InverseKey : Key;
+			uint8_t j = NumberOfCopies++;
+			for(; j > 0 && Copies[j - 1] < CopyKey; j--) Copies[j] = Copies[j - 1];
+			Copies[j] = CopyKey;
+		}
+	}
+
+	uint8_t FreeSlot = 0;
+	for(uint8_t c = 0; c < NumberOfCopies; c++)
+	{
+		uint16_t const CandidateIndex = Copies[c] & 0xFFFF;
+		uint8_t const Source = CandidateIndex < Candidates ? CandidateIndex : CandidateIndex - Candidates;
+
+		while(SlotUsed[FreeSlot]) FreeSlot++; // a free slot exists: at most NumberOfDecoders candidates survive
+		CopyBatchPath(Context, Batch, Frames, Frame, Source, FreeSlot, Leaf);
+		STATS_ADD(Context, PathForks, 1);
+		SetBitAtIndex(GetBatchDecisions(Batch, FreeSlot, n), Index, DecoderDecisions[CandidateIndex].Decision);
+		History[FreeSlot] = (uint16_t)(Source << 1) | DecoderDecisions[CandidateIndex].Decision;
+		PathMetrics[FreeSlot] = DecoderDecisions[CandidateIndex].PathMetric;
+		SlotUsed[FreeSlot] = 1;
+		NumberOfPaths++;
+	}
+
+	//normalize to the lowest path metric
+	PathMetric_t Minimum = 0;
+	bool First = true;
+	for(uint8_t i = 0; i < NumberOfDecoders; i++)
+	{
+		if(SlotUsed[i] && (First || PathMetrics[i] < Minimum)) Minimum = PathMetrics[i];
+		First = First && !SlotUsed[i];
+	}
+	for(uint8_t i = 0; i < NumberOfDecoders; i++)
+	{
+		if(SlotUsed[i]) PathMetrics[i] -= Minimum;
+	}
+
+	Batch->NumberOfPaths[Frame] = NumberOfPaths;
+}
+
+bool PLC_SCL_Decode_Batch(PLC_Context *const Context, PLC_Batch *const Batch,
+						  uint8_t const *const Inputs, uint16_t const NumberOfFrames,
+						  uint8_t const *const FrozenBitMask, uint32_t const FrozenBitMaskLength,
+						  uint8_t *const Outputs, uint8_t *const NumberOfPaths)
+{
+	if(Context == 0 || Context->Workspace == 0 || Batch == 0) return false;
+	if(Batch->N != Context->N || Batch->NumberOfDecoders != Context->NumberOfDecoders) return false;
+	if(Inputs == 0 || Outputs == 0 || NumberOfFrames == 0 || NumberOfFrames > Batch->BatchSize) return false;
+	if(FrozenBitMask == 0 || FrozenBitMaskLength != Context->NBytes) return false;
+
+	uint32_t const N = Context->N;
+	uint32_t const NBytes = Context->NBytes;
+	uint8_t const NumberOfDecoders = Context->NumberOfDecoders;
+	PLC_Kernels const*const Kernels = Context->Kernels;
+	uint16_t const Frames = NumberOfFrames; // interleaving stride
+
+	STATS_ADD(Context, DecoderCalls, 1);
+	STATS_START(Lap);
+
+	//plan without node specializations: closed form nodes fork per frame
+	PLC_Plan const*const Plan = GetPlan(Context, FrozenBitMask, 0, false);
+	if(Plan == 0) return false;
+	STATS_LAP(Context, PLC_Stage_Plan, Lap);
+
+	//input values BPSK encoded, one path per frame
+	BPSK_t *const ChannelLLRs = GetBatchLLRs(Context, Batch, 0, 0);
+	for(uint16_t Frame = 0; Frame < Frames; Frame++)
+	{
+		for(uint32_t j = 0; j < N; j++)
+		{
+			ChannelLLRs[(uint32_t)j * Frames + Frame] = ToBPSK(GetBitAtIndex(Inputs + Frame * NBytes, j));
+		}
+		Batch->NumberOfPaths[Frame] = 1;
+		Batch->PathMetrics[Frame * NumberOfDecoders] = 0;
+	}
+	uint8_t ActiveSlots = 1; // max. number of paths over all frames
+	uint32_t InfoBitIndex = 0;
+
+	for(uint32_t Step = 0; Step < Plan->NumberOfInstructions; Step++)
+	{
+		PlanInstruction const*const Instruction = &Plan->Instructions[Step];
+		uint16_t const Depth = Instruction->Depth;
+		uint32_t const Length = (uint32_t)Instruction->Length * Frames;
+
+		switch(Instruction->Operation)
+		{
+		case PO_F:
+			for(uint8_t Slot = 0; Slot < ActiveSlots; Slot++)
+			{
+				BPSK_t const*const a = GetBatchLLRs(Context, Batch, Slot, Depth);
+				Kernels->f(GetBatchLLRs(Context, Batch, Slot, Depth + 1), a, a + Length, Length);
+			}
+			STATS_ADD(Context, FOperations, ActiveSlots);
+			STATS_ADD(Context, FElements, (uint64_t)ActiveSlots * Length);
+			STATS_LAP(Context, PLC_Stage_F, Lap);
+			break;
+		case PO_G:
+			for(uint8_t Slot = 0; Slot < ActiveSlots; Slot++)
+			{
+				BPSK_t const*const a = GetBatchLLRs(Context, Batch, Slot, Depth);
+				Kernels->g(GetBatchLLRs(Context, Batch, Slot, Depth + 1), a, a + Length, GetBatchDecisions(Batch, Slot, Depth + 1), 0, Length);
+			}
+			STATS_ADD(Context, GOperations, ActiveSlots);
+			STATS_ADD(Context, GElements, (uint64_t)ActiveSlots * Length);
+			STATS_LAP(Context, PLC_Stage_G, Lap);
+			break;
+		case PO_Combine:
+			if(Instruction->Offset + 2u * Instruction->Length >= Context->N) break; // rightmost path (plans providing the code word): never read by the batch decoder
+			{
+				uint32_t const NodeIndex = (Instruction->Offset & (2u * Instruction->Length)) * Frames; // node's half of its parent's children (the root is never combined)
+				for(uint8_t Slot = 0; Slot < ActiveSlots; Slot++)
 				{
-					uint8_t const CurrentDecoderId = DecoderDecisions[i].DecoderId;
-					if(i >= NumberOfDecoders)
-					{
-						DecodersVisited[CurrentDecoderId]++;
-						if(DecodersVisited[CurrentDecoderId] >= 2) //all instances of this decoder are outside of viable decision spectrum -> free up space
-						{
-							DeleteDecoder(Decoders[CurrentDecoderId]);
-							Decoders[CurrentDecoderId] = 0;
-							CurrentDecoders--;
-						}
-					}
-					else
-					{
-						if(DecodersVisited[CurrentDecoderId] == 0) { // both instances of this decoder are inside the viable decision spectrum -> copy and set to free space
-							//copy and assign values
-							DecoderData* CopiedDecoder = CopyDecoder(Decoders[CurrentDecoderId]);
-							SetDecision(CopiedDecoder, Depth, Node, DecoderDecisions[i].Decision);
-							CopiedDecoder->PathMetrics = DecoderDecisions[i].PathMetric;
-
-							//find free position
-							int8_t FreeDecoderPosition = -1;
-							for(uint8_t i = 0; i < NumberOfDecoders && FreeDecoderPosition == -1; i++)
-							{
-								if(Decoders[i] == 0) FreeDecoderPosition = i;
-							}
-
-							if(FreeDecoderPosition < 0) // critical error!!!!!
-							{
-								free(CopiedDecoder);
-								free(DecoderDecisions);
-								free(DecodersVisited);
-								free(NodeStates);
-								for(uint8_t i = 0; i < NumberOfDecoders; i++)
-								{
-									DeleteDecoder(Decoders[i]);
-								}
-								free(Decoders);
-								return 0;
-							}
-
-							//add to decoders
-							Decoders[FreeDecoderPosition] = CopiedDecoder;
-
-							//increase value to indicate no further copy necessary
-							DecodersVisited[CurrentDecoderId]++;
-							CurrentDecoders++;
-						}
-						else //only 1 instance of this decoder is inside the viable decision spectrum -> assign values
-						{
-							SetDecision(Decoders[CurrentDecoderId], Depth, Node, DecoderDecisions[i].Decision);
-							Decoders[CurrentDecoderId]->PathMetrics = DecoderDecisions[i].PathMetric;
-							
-							DecodersVisited[CurrentDecoderId]++;
-						}
-					}
+					Kernels->Combine(GetBatchDecisions(Batch, Slot, Depth), NodeIndex, GetBatchDecisions(Batch, Slot, Depth + 1), 0, Length, Length);
 				}
-				
-				free(DecoderDecisions);
-				free(DecodersVisited);
+			}
+			STATS_ADD(Context, CombineOperations, ActiveSlots);
+			STATS_ADD(Context, CombineElements, (uint64_t)ActiveSlots * Length);
+			STATS_LAP(Context, PLC_Stage_Combine, Lap);
+			break;
+		case PO_FrozenLeaf:
+			for(uint8_t Slot = 0; Slot < ActiveSlots; Slot++)
+			{
+				BPSK_t const*const LLRs = GetBatchLLRs(Context, Batch, Slot, Depth);
+				Decision_t *const Decisions = GetBatchDecisions(Batch, Slot, Depth);
+				uint32_t const Index = (Instruction->Offset & 1) * Frames;
 
-				if(CurrentDecoders > NumberOfDecoders) // critical error!!!!!
+				for(uint16_t Frame = 0; Frame < Frames; Frame++)
 				{
-					free(NodeStates);
-					for(uint8_t i = 0; i < NumberOfDecoders; i++)
+					SetBitAtIndex(Decisions, Index + Frame, 0); // bit is frozen -> value is set to 0 (-> "frozen") during encoding
+					if(LLRs[Frame] < 0 && Slot < Batch->NumberOfPaths[Frame])
 					{
-						DeleteDecoder(Decoders[i]);
+						PathMetric_t *const PathMetric = &Batch->PathMetrics[Frame * NumberOfDecoders + Slot];
+						*PathMetric = AddMetrics(*PathMetric, GetMagnitude(LLRs[Frame]));
 					}
-					free(Decoders);
-					return 0;
 				}
 			}
-
-			//next node: parent
-			Node = (uint16_t)floor(Node / 2.0);
-			Depth -= 1;
+			STATS_ADD(Context, FrozenLeaves, (uint64_t)ActiveSlots * Frames);
+			STATS_LAP(Context, PLC_Stage_Leaves, Lap);
+			break;
+		case PO_InfoLeaf:
+			ActiveSlots = 0;
+			for(uint16_t Frame = 0; Frame < Frames; Frame++)
+			{
+				ForkBatchPaths(Context, Batch, Frames, Frame, Instruction->Offset, InfoBitIndex);
+				if(Batch->NumberOfPaths[Frame] > ActiveSlots) ActiveSlots = Batch->NumberOfPaths[Frame];
+			}
+			InfoBitIndex++;
+			STATS_LAP(Context, PLC_Stage_Leaves, Lap);
+			break;
+		default: return false;
 		}
-		else // -> interior node
+	}
+
+	//plain texts of all paths: traced back through the history (frozen bits are 0)
+	memset(Outputs, 0, (uint32_t)Frames * NumberOfDecoders * NBytes);
+	for(uint16_t Frame = 0; Frame < Frames; Frame++)
+	{
+		for(uint8_t Slot = 0; Slot < Batch->NumberOfPaths[Frame]; Slot++)
 		{
-			switch (GetNodeState(NodeStates, Depth, Node))
+			uint8_t *const Output = Outputs + ((uint32_t)Frame * NumberOfDecoders + Slot) * NBytes;
+			uint32_t Bit = InfoBitIndex;
+			uint8_t Path = Slot;
+
+			for(int32_t Leaf = N - 1; Leaf >= 0; Leaf--)
 			{
-			case NS_Untouched: // step "L" (left node)
-				{
-					uint16_t const NumberIncomingBeliefs = (uint16_t)pow(2, n - Depth);
-					uint16_t const NumberOutgoingBeliefs = NumberIncomingBeliefs / 2;
+				if(!GetBitAtIndex(FrozenBitMask, Leaf)) continue;
+
+				uint16_t const Entry = Batch->History[((size_t)--Bit * Frames + Frame) * NumberOfDecoders + Path];
+				SetBitAtIndex(Output, Leaf, Entry & 1);
+				Path = Entry >> 1;
+			}
+		}
+		if(NumberOfPaths != 0) NumberOfPaths[Frame] = Batch->NumberOfPaths[Frame];
+	}
+	STATS_LAP(Context, PLC_Stage_Output, Lap);
 
-					//next node: left child
-					uint16_t const NextNode = Node * 2;
-					uint16_t const ChildDepth = Depth + 1;
+	return true;
+}
 
-					for(uint8_t i = 0; i < CurrentDecoders; i++)
-					{
-						BPSK_t* a = GetLLRRange(Decoders[i], Depth, Node * NumberIncomingBeliefs, Node * NumberIncomingBeliefs + NumberIncomingBeliefs / 2);
-						BPSK_t* b = GetLLRRange(Decoders[i], Depth, Node * NumberIncomingBeliefs + NumberIncomingBeliefs / 2, Node * NumberIncomingBeliefs + NumberIncomingBeliefs);
+// --- REPRODUCE - decoding passes --- //
 
-						BPSK_t* MinSumRay = MinSumArray(a, b, NumberIncomingBeliefs);
-						SetLLRRange(Decoders[i], ChildDepth, NumberOutgoingBeliefs * NextNode, NumberOutgoingBeliefs * (NextNode + 1), MinSumRay);
+/// @brief Decodes and derives the key from the candidate matching the validation hash (CRC aided -> only the validated winner is hashed). No heap allocations, once the plan is cached.
+/// Adaptive list size (PLC_SetAdaptiveListSize): passes with L = 1, 2, 4, ... until a key is found, the decoder input and the plan are reused by every pass.
+/// @param Input Hard decision decoder input, nullptr -> soft input placed in Workspace->ChannelLLRs beforehand.
+/// @param CRCValues Expected CRC values, nullptr -> no CRC check.
+/// @param Key Output, DigestLength bytes.
+/// @return True on success. The list size of the successful pass is kept as the context's effective list size.
+static bool DecodeAndDeriveKey(PLC_Context *const Context, uint8_t const *const Input, uint8_t const *const FrozenBitMask, uint16_t const *const CRCValues,
+							   uint8_t const *const ValidationHash, uint8_t *const Key)
+{
+	PLC_Workspace *const Workspace = Context->Workspace;
+	DecoderData *const*const Decoders = Workspace->Decoders;
+	PLC_HashProvider const*const Hash = Context->Hash;
+	uint8_t const NumberOfDecoders = Context->NumberOfDecoders;
+	uint8_t const MaxListSize = Context->MaxListSize > 0 && Context->MaxListSize < NumberOfDecoders ? Context->MaxListSize : NumberOfDecoders;
+	uint8_t ListSize = Context->MaxListSize > 0 ? 1 : NumberOfDecoders;
 
-						free(a);
-						free(b);
-						free(MinSumRay);
-					}
+	if(Input != 0) SetHardInput(Context, Input);
 
-					SetNodeState(NodeStates, Depth, Node, NS_LeftDone);
-					Node = NextNode;
-					Depth = ChildDepth;
-				}
-				break;
-			case NS_LeftDone: // step "R" (right node)
-				{
-					uint16_t const NumberIncomingBeliefs = (int)pow(2, n - Depth);
-					uint16_t const NumberOutgoingBeliefs = NumberIncomingBeliefs / 2;
-					uint16_t const LeftChildNode = 2 * Node;
-					uint16_t const ChildDepth = Depth + 1;
+	while(true)
+	{
+		uint8_t const CurrentDecoders = SCL_Decode(Context, ListSize, FrozenBitMask, CRCValues, true);
 
-					//next node: right child
-					uint16_t const NextNode = Node * 2 + 1;
+		//candidates are read from the decoders' plain text and code word rows (-> no copies, no re-encoding)
+		bool Found = false;
+		if(CurrentDecoders > 0 && CRCValues != 0)
+		{
+			DecoderData const*const Best = Decoders[GetBestDecoder(Context, CurrentDecoders)];
+			Found = DeriveKey(Context, Best->Decisions[Context->n], Best->Decisions[0], FrozenBitMask, 0, ValidationHash, Key);
+		}
+		else if(CurrentDecoders > 1 && Hash->HashMany != 0)
+		{
+			//multi-buffer: all candidates hashed at once
+			for(uint8_t i = 0; i < CurrentDecoders; i++)
+			{
+				Workspace->Candidates[i] = Decoders[i]->Decisions[Context->n];
+			}
+			STATS_START(Lap);
+			bool const Hashed = Hash->HashMany(Hash->UserData, Workspace->Candidates, CurrentDecoders, Context->NBytes, Workspace->Digests);
+			STATS_LAP(Context, PLC_Stage_Hash, Lap);
 
-					for(uint8_t i = 0; i < CurrentDecoders; i++)
-					{
-						BPSK_t* a = GetLLRRange(Decoders[i], Depth, Node * NumberIncomingBeliefs, Node * NumberIncomingBeliefs + NumberIncomingBeliefs / 2);
-						BPSK_t* b = GetLLRRange(Decoders[i], Depth, Node * NumberIncomingBeliefs + NumberIncomingBeliefs / 2, Node * NumberIncomingBeliefs + NumberIncomingBeliefs);
-						Decision_t* IncomingDecisions = GetDecisionsRange(Decoders[i], ChildDepth, NumberOutgoingBeliefs * LeftChildNode, NumberOutgoingBeliefs * LeftChildNode + NumberOutgoingBeliefs);
+			for(uint8_t i = 0; i < CurrentDecoders && Hashed && !Found; i++)
+			{
+				Found = DeriveKey(Context, Decoders[i]->Decisions[Context->n], Decoders[i]->Decisions[0], FrozenBitMask,
+								  Workspace->Digests + i * Hash->DigestLength, ValidationHash, Key);
+			}
+		}
+		else
+		{
+			for(uint8_t i = 0; i < CurrentDecoders && !Found; i++)
+			{
+				Found = DeriveKey(Context, Decoders[i]->Decisions[Context->n], Decoders[i]->Decisions[0], FrozenBitMask, 0, ValidationHash, Key);
+			}
+		}
 
-						BPSK_t* gRay = gArray(a, b, IncomingDecisions, NumberIncomingBeliefs);
-						SetLLRRange(Decoders[i], ChildDepth, NumberOutgoingBeliefs * NextNode, NumberOutgoingBeliefs * (NextNode + 1), gRay);
+		if(Found)
+		{
+			Context->EffectiveListSize = ListSize;
+			return true;
+		}
+		if(ListSize >= MaxListSize) return false;
 
-						free(a);
-						free(b);
-						free(IncomingDecisions);
-						free(gRay);
-					}
+		ListSize = 2 * ListSize < MaxListSize ? 2 * ListSize : MaxListSize;
+	}
+}
 
-					SetNodeState(NodeStates, Depth, Node, NS_RightDone);
-					Node = NextNode;
-					Depth = ChildDepth;
-				}
-				break;
-			case NS_RightDone: // step "U" (center / to parent)
-				{
-					uint16_t const NumberIncomingBeliefs = (uint16_t)pow(2, n - Depth);
-					uint16_t const NumberOutgoingBeliefs = NumberIncomingBeliefs / 2;
-					uint16_t const LeftChildNode = 2 * Node;
-					uint16_t const RightChildNode = LeftChildNode + 1;
-					uint16_t const ChildDepth = Depth + 1;
+// --- REPRODUCE (multiple readouts) --- //
 
-					for(uint16_t i = 0; i < CurrentDecoders; i++)
-					{
-						Decision_t* LeftChildDecisions = GetDecisionsRange(Decoders[i], ChildDepth, NumberOutgoingBeliefs * LeftChildNode, NumberOutgoingBeliefs * (LeftChildNode + 1));
-						Decision_t* RightChildDecisions = GetDecisionsRange(Decoders[i], ChildDepth, NumberOutgoingBeliefs * RightChildNode, NumberOutgoingBeliefs * (RightChildNode + 1));
+#ifdef PLC_LLR_INT8
+	#define SoftLLRScale 2		// quantization steps per nat, halved -> sums of the LLRs saturate later
+	#define SoftLLRKnownBit 16	// LLR magnitude of bits known for certain (frozen bits, helper data), exceeds every readout LLR (SoftLLRScale * ln(2 * 255 + 1) < 13)
+#else
+	#define SoftLLRScale 4		// quantization steps per nat
+	#define SoftLLRKnownBit 32	// LLR magnitude of bits known for certain (frozen bits, helper data), exceeds every readout LLR (SoftLLRScale * ln(2 * 255 + 1) < 26)
+#endif
 
-						Decision_t* Decisions = calloc(ceil(NumberOutgoingBeliefs / 8.0), sizeof(Decision_t));
-						for(uint16_t j = 0; j < NumberOutgoingBeliefs; j++)
-						{
-							SetBitAtIndex(Decisions, j, (GetBitAtIndex(LeftChildDecisions, j) + GetBitAtIndex(RightChildDecisions, j)) % 2);
-						}
+/// @brief Encoder in the LLR domain: XOR of two bits -> min-sum of their LLRs (in place).
+static void EncodeSoftInPlace(PLC_Context const*const Context, BPSK_t *const Values)
+{
+	uint32_t const N = Context->N;
 
-						SetDecisionsRange(Decoders[i], Depth, NumberIncomingBeliefs * Node, Node * NumberIncomingBeliefs + NumberIncomingBeliefs / 2, Decisions);
-						SetDecisionsRange(Decoders[i], Depth, NumberIncomingBeliefs * Node + NumberIncomingBeliefs / 2, NumberIncomingBeliefs * Node + NumberIncomingBeliefs, RightChildDecisions);
+	for(uint32_t m = 1; m < N; m *= 2)
+	{
+		for(uint32_t i = 0; i < N; i += 2 * m)
+		{
+			Context->Kernels->f(Values + i, Values + i, Values + i + m, m);
+		}
+	}
+}
 
-						free(LeftChildDecisions);
-						free(RightChildDecisions);
-						free(Decisions);
-					}
+uint8_t *PLC_Reproduce_MultiReadout(PLC_Context *const Context,
+	uint8_t const *const *const Fingerprints, uint8_t const NumberOfReadouts, uint32_t const FingerprintLength,
+	uint8_t const *const HelperData, uint32_t const HelperDataSize,
+	uint8_t const *const FrozenBitMask, uint32_t const FrozenBitMaskLength,
+	uint8_t const *const ValidationHash, uint16_t const ValidationHashLength)
+{
+	if(Context == 0) return 0;
 
-					SetNodeState(NodeStates, Depth, Node, NS_Done);
+	uint8_t* Key = malloc(Context->Hash->DigestLength);
+	if(Key == 0) return 0;
+	STATS_ADD(Context, Allocations, 1);
 
-					//next node: parent
-					Node = (uint16_t)floor(Node / 2.0);
-					Depth -= 1;
+	if(!PLC_Reproduce_MultiReadout_Into(Context, Fingerprints, NumberOfReadouts, FingerprintLength, HelperData, HelperDataSize,
+										FrozenBitMask, FrozenBitMaskLength, ValidationHash, ValidationHashLength, Key, Context->Hash->DigestLength))
+	{
+		free(Key);
+		return 0;
+	}
 
-					if(Depth < 0) Done = true;
-				}
-				break;
-			default: break;
-			}
-		}
+	return Key;
+}
+
+bool PLC_Reproduce_MultiReadout_Into(PLC_Context *const Context_,
+	uint8_t const *const *const Fingerprints, uint8_t const NumberOfReadouts, uint32_t const FingerprintLength,
+	uint8_t const *const HelperData, uint32_t const HelperDataSize,
+	uint8_t const *const FrozenBitMask, uint32_t const FrozenBitMaskLength,
+	uint8_t const *const ValidationHash, uint16_t const ValidationHashLength,
+	uint8_t *const Key, uint16_t const KeyLength)
+{
+	PLC_Context *const Context = Context_ != 0 ? Context_ : GetDefaultContext();
+	if(Context->Workspace == 0) return false;
+	uint32_t const N = Context->N;
+	uint32_t const NBytes = Context->NBytes;
+	Context->EffectiveListSize = 0;
+
+	if(Fingerprints == 0 || NumberOfReadouts == 0 || FingerprintLength < NBytes) return false;
+	if(HelperData == 0 || HelperDataSize < PLC_GetHelperDataSize(Context)) return false; // as written by PLC_Enroll (K = N -> no frozen bits, 0 bytes)
+	if(FrozenBitMask == 0 || FrozenBitMaskLength != NBytes || CountInfoBits(FrozenBitMask, NBytes) != Context->K) return false; // K information bits -> N - K helper bits
+	if(ValidationHash == 0 || ValidationHashLength != Context->Hash->DigestLength) return false;
+	if(Key == 0 || KeyLength < Context->Hash->DigestLength) return false;
+	for(uint8_t r = 0; r < NumberOfReadouts; r++)
+	{
+		if(Fingerprints[r] == 0) return false;
 	}
 
-	//copy decoder decisions to output list
-	uint8_t** Output = malloc(NumberOfDecoders * sizeof(uint8_t*));
-	for(uint16_t i = 0; i < NumberOfDecoders; i++)
+	//LLR of a cell, depending on how often it was read as 1 (-> empirical flip rate)
+	BPSK_t ReadoutLLRs[256];
+	for(uint16_t Ones = 0; Ones <= NumberOfReadouts; Ones++)
 	{
-		if(i < CurrentDecoders)
+		ReadoutLLRs[Ones] = (BPSK_t)lround(SoftLLRScale * log((NumberOfReadouts - Ones + 0.5) / (Ones + 0.5)));
+	}
+
+	//fuse readouts + apply frozen bit mask (frozen bits are 0 for certain)
+	BPSK_t *const LLRs = Context->Workspace->ChannelLLRs;
+	for(uint32_t i = 0; i < N; i++)
+	{
+		if(!GetBitAtIndex(FrozenBitMask, i))
 		{
-			Output[i] = malloc((uint16_t)ceil(N / 8.0) * sizeof(uint8_t));
-			memcpy(Output[i], Decoders[i]->Decisions[n], (uint16_t)ceil(N / 8.0));
-			DeleteDecoder(Decoders[i]);
+			LLRs[i] = SoftLLRKnownBit;
+			continue;
 		}
-		else
+
+		uint16_t Ones = 0;
+		for(uint8_t r = 0; r < NumberOfReadouts; r++)
 		{
-			Output[i] = 0;
+			Ones += GetBitAtIndex(Fingerprints[r], i);
 		}
+		LLRs[i] = ReadoutLLRs[Ones];
 	}
 
-	free(Decoders);
-	free(NodeStates);
+	//encode (systematic code: the readouts are the information bits of the code word)
+	if(!Context->Systematic)
+	{
+		STATS_START(Lap);
+		EncodeSoftInPlace(Context, LLRs);
+		STATS_LAP(Context, PLC_Stage_Encode, Lap);
+	}
 
-	return Output;
+	//apply helper data (known for certain)
+	for(uint32_t i = 0, HDIndex = 0; i < N && (HDIndex / 8) < HelperDataSize; i++)
+	{
+		if(!GetBitAtIndex(FrozenBitMask, i))
+		{
+			LLRs[i] = GetBitAtIndex(HelperData, HDIndex) ? -SoftLLRKnownBit : SoftLLRKnownBit;
+			HDIndex++;
+		}
+	}
+
+	//decode, CRC aided -> only the validated winner is left, the hash is the final confirmation
+	bool const UseCRC = Context->CRC.Length > 0;
+	uint16_t *const CRCValues = Context->Workspace->CRCValues;
+	if(UseCRC && !ReadCRCValues(Context, HelperData, HelperDataSize, CRCValues)) return false;
+
+	return DecodeAndDeriveKey(Context, 0, FrozenBitMask, UseCRC ? CRCValues : 0, ValidationHash, Key);
 }
@@ -1,6 +1,8 @@
 #ifndef PLC_HASCL_H
 #define PLC_HASCL_H
 #include <stdint.h>
+#include <stdbool.h>
+#include "PolarCodes_Hash.h"
 
 /*  This is a Polar Code encoder + successive cancellation list decoder optimized for memory usage 
 *   and is based on the tutorial series "LDPC and Polar Codes in 5G Standard" by NPTEL-NOC IITM.
@@ -11,38 +13,281 @@
 *   
 *   Notes:
 *   FrozenBitMask - frozen bits are indicated by the value 0, non-frozen bits are 1.
-*   This implementation (especially PLC_Reproduce) makes use of Tom Crypt's SHA1 hashing function.
-*   Either include Tom Crypt into your project, or remove code (when PLC_Reproduce is not used).
+*   Masks can be created with PLC_CreateFrozenBitMask (PolarCodes_Construction.h).
+*   Validation hash and key derivation use a hash provider (PolarCodes_Hash.h, built-in SHA-1 / SHA-256 -> no crypto lib needed),
+*   own hash functions can be registered per context (PLC_SetHashProvider).
 */
 
-#define OutputKeyLengthByte 20
+#define OutputKeyLengthByte 20 // key length of the default hash function (SHA-1), see PLC_GetKeyLength
+#define PLC_MaxBlockLength (1u << 20) // largest word length N (in bits), all indices and lengths are 32 bit
 
-/// @brief Initializes this module.
+/// @brief Opaque context, carrying the code parameters (N, K, NumberOfDecoders) and everything derived from them.
+/// Contexts are independent of each other -> multiple code configurations / threads can be used at once (one context per thread).
+/// Each context owns a workspace (sized once from N and the list size), which holds all scratch memory used during decoding.
+typedef struct PLC_Context PLC_Context;
+
+/// @brief Creates a new context.
+/// @param N Word length (in bits). Has to be a power of 2 (8 ... PLC_MaxBlockLength).
+/// @param K Codeword length / raw key length (in bits).
+/// @param NumberOfDecoders Number of decoders (for list decoding).
+/// @return New context (free with PLC_DeleteContext). Nullptr on error.
+PLC_Context* PLC_CreateContext(uint32_t const N, uint32_t const K, uint8_t const NumberOfDecoders);
+
+/// @brief Creates a new context with the configuration of the given one (code parameters, node specializations, CRC), but its own workspace and plan cache.
+/// Use it to hand one context to every thread.
+/// @param Context Context to copy the configuration from, nullptr -> default context (PLC_Init).
+/// @return New context (free with PLC_DeleteContext). Nullptr on error.
+PLC_Context* PLC_CloneContext(PLC_Context const*const Context);
+
+/// @brief Deletes a context -> frees memory.
+void PLC_DeleteContext(PLC_Context* Context);
+
+/// @brief Reads the code parameters of a context.
+/// @param Context Context, nullptr -> default context (PLC_Init).
+/// @param N Output (optional): word length (in bits).
+/// @param K Output (optional): codeword length (in bits).
+/// @param NumberOfDecoders Output (optional): list size.
+void PLC_GetCodeParameters(PLC_Context const*const Context, uint32_t *const N, uint32_t *const K, uint8_t *const NumberOfDecoders);
+
+/// @brief Configures CRC aided decoding for the given context: a CRC over the information bits (in index order) is checked during decoding at every checkpoint,
+/// paths failing the check are dropped. The expected CRC values are computed during enrollment (PLC_ComputeCRC) and stored with the helper data,
+/// because the information bits are taken from the fingerprint (-> no room for CRC bits in the plain text).
+/// @param Length CRC length (in bits, max. 16), e.g. 8, 11 or 16. 0 disables CRC aided decoding.
+/// @param Polynomial Generator polynomial without the leading x^Length term, e.g. 0x07 (CRC-8), 0x621 (CRC-11) or 0x1021 (CRC-16-CCITT).
+/// @param Checkpoints Information bit indices (0 ... K-1, ascending), after which a CRC is checked. Each CRC covers the information bits since the previous checkpoint.
+///                    Nullptr -> a single CRC over all information bits.
+/// @param NumberOfCheckpoints Number of checkpoints.
+/// @return True on success, false on invalid parameters.
+bool PLC_SetCRC(PLC_Context *const Context, uint8_t const Length, uint16_t const Polynomial,
+                uint32_t const*const Checkpoints, uint8_t const NumberOfCheckpoints);
+
+/// @brief Computes the CRC value of every checkpoint for a given plain text (enrollment side of CRC aided decoding).
+/// For PLC_Reproduce, the values are appended to the helper data: starting at byte (N - K + 7) / 8, 2 bytes each (little endian).
+/// @param Input Plain text (frozen bit mask applied). Only first N bits are used.
+/// @param InputLength Length of input (in bytes).
+/// @param CRCValues Output, one value per checkpoint.
+/// @return Number of CRC values written, 0 on error (or CRC disabled).
+uint8_t PLC_ComputeCRC(PLC_Context const*const Context, uint8_t const*const Input, uint32_t const InputLength,
+                       uint8_t const*const FrozenBitMask, uint32_t const FrozenBitMaskLength, uint16_t *const CRCValues);
+
+/// @brief Fast-SSC node specializations (see PLC_SetFastNodes).
+#define PLC_FastNode_Rate0 0x01	// all bits frozen
+#define PLC_FastNode_Rate1 0x02	// no bit frozen
+#define PLC_FastNode_REP 0x04	// repetition: all bits frozen, except the last one
+#define PLC_FastNode_SPC 0x08	// single parity check: no bit frozen, except the first one
+#define PLC_FastNode_All 0x0F
+
+/// @brief Enables decoding of special subtrees in closed form (Fast-SSC), instead of traversing them down to every leaf.
+/// The subtrees are classified from the frozen bit mask. For low rate codes (e.g. K / N = 1/8) most of the tree consists of Rate-0 and repetition nodes.
+/// Within Rate-1 and SPC nodes the list forks on the least reliable bits only (min(L - 1, size) resp. min(L, size)) and path metrics are taken from the node's LLRs
+/// -> the output list may differ slightly from the bit by bit decoder. Disabled by default.
+/// @param Flags Combination of PLC_FastNode_... flags, 0 -> bit by bit decoding.
+/// @return True on success, false on invalid parameters.
+bool PLC_SetFastNodes(PLC_Context *const Context, uint8_t const Flags);
+
+/// @brief Enables adaptive list sizes for reproduction (PLC_Reproduce_Ctx, PLC_Reproduce_MultiReadout): decoding starts with plain successive cancellation (L = 1)
+/// and is repeated with L = 2, 4, 8, ... up to the cap only while no candidate matches the validation hash (resp. all paths fail the CRC).
+/// Most readouts are reproduced in the first pass -> the average latency drops, the worst case corrects as many errors as the full list (plus the failed passes).
+/// The decoder input, the plan and the workspace are reused by every pass. Disabled by default (-> always the full list).
+/// @param MaxListSize Largest list size tried (<= NumberOfDecoders of the context), 0 -> disabled.
+/// @return True on success, false on invalid parameters.
+bool PLC_SetAdaptiveListSize(PLC_Context *const Context, uint8_t const MaxListSize);
+
+/// @brief List size of the decoding pass which reproduced the key in the last call of PLC_Reproduce_Ctx / PLC_Reproduce_MultiReadout with this context.
+/// @return List size, 0 if the last reproduction failed.
+uint8_t PLC_GetEffectiveListSize(PLC_Context const*const Context);
+
+/// @brief Enables systematic polar coding: the information bits are the non-frozen bits of the code word (see PLC_Encode_Systematic) instead of the plain text.
+/// Reproduction then takes the fingerprint bits as they are (no encoding -> readout errors are not spread over the word) and PLC_SCL_Decode_InfoBits returns the information bits of the code word estimates.
+/// The plain text (-> validation hash, CRC) is still u with x = u * F^(xn). Disabled by default. Helper data has to be generated in the same mode.
+/// @return True on success, false on invalid parameters.
+bool PLC_SetSystematic(PLC_Context *const Context, bool const Enable);
+
+/// @brief Lets the list decoders (PLC_SCL_Decode_Ctx / _Soft / _CRC / _Into) return the code word estimate x = u * F^(xn) of every path instead of its plain text u.
+/// The decoder combines the decisions up to the root for this (-> no separate encoding). Not used by the batch decoder. Disabled by default.
+/// @return True on success, false on invalid parameters.
+bool PLC_SetCodeWordOutput(PLC_Context *const Context, bool const Enable);
+
+/// @brief Registers the hash function of the validation hash and the key derivation (enrollment, reproduction). The provider is kept by reference, not copied.
+/// Default: built-in SHA-1, hardware accelerated where the CPU supports it (see PLC_GetHashProvider). Helper data has to be generated with the same hash function.
+/// @param Provider Provider (has to outlive the context), nullptr -> default.
+/// @return True on success, false on invalid parameters.
+bool PLC_SetHashProvider(PLC_Context *const Context, PLC_HashProvider const*const Provider);
+
+/// @brief Key length (and validation hash length) of a context: digest length of its hash provider.
+/// @param Context Context, nullptr -> context of the legacy API.
+/// @return Length in bytes.
+uint8_t PLC_GetKeyLength(PLC_Context const*const Context);
+
+/// @brief Decoding plan: the tree traversal for a frozen bit mask, compiled into a flat instruction list.
+/// Plans are compiled on first use and cached per context (by frozen bit mask and node specializations) -> repeated decoding with the same mask skips all schedule work.
+typedef struct PLC_Plan PLC_Plan;
+
+/// @brief Returns the decoding plan for the given frozen bit mask, compiles (and caches) it if not done yet. Use it to compile plans ahead of time.
+/// The plan provides the code word estimate too (-> usable by every decoding function of the context, including reproduction).
+/// @return Plan (owned by the context, valid until it is evicted from the cache), nullptr on error.
+PLC_Plan const* PLC_GetPlan(PLC_Context *const Context, uint8_t const*const FrozenBitMask, uint32_t const FrozenBitMaskLength);
+
+/// @brief Stages timed by the statistics (see PLC_Stats).
+typedef enum
+{
+	PLC_Stage_Encode,		// encoder (PLC_Encode_..., re-encoding during reproduction)
+	PLC_Stage_Plan,			// plan lookup and compilation
+	PLC_Stage_F,			// f steps (left child LLRs)
+	PLC_Stage_G,			// g steps (right child LLRs)
+	PLC_Stage_Combine,		// combine steps (partial sums to the parent)
+	PLC_Stage_Leaves,		// frozen and information leaves, incl. path forks and selection
+	PLC_Stage_FastNodes,	// specialized nodes (PLC_SetFastNodes)
+	PLC_Stage_CRC,			// CRC checks
+	PLC_Stage_Output,		// copying the surviving paths to the output
+	PLC_Stage_Hash,			// hashes of the candidates and of the raw key (PLC_Reproduce)
+	PLC_NumberOfStages
+} PLC_Stage;
+
+/// @brief Hot path counters and per stage timers of a context, accumulated over all calls until PLC_ResetStats (reset before a call -> numbers of this call).
+/// Only collected if the library is built with PLC_ENABLE_STATS, otherwise compiled out completely. Counters are not synchronized: with stats enabled,
+/// a context must not be used by several threads at once (not even by the functions taking a const context).
+typedef struct
+{
+	uint64_t DecoderCalls;		// list decoder runs (a batch counts once)
+	uint64_t FOperations;		// f steps, per path (batch: per path slot)
+	uint64_t FElements;			// LLRs computed by f steps
+	uint64_t GOperations;
+	uint64_t GElements;
+	uint64_t CombineOperations;
+	uint64_t CombineElements;	// decisions combined
+	uint64_t PathForks;			// paths copied (CopyDecoder calls)
+	uint64_t BytesCopied;		// bytes copied by forks and copy on write
+	uint64_t PathKills;			// paths dropped by the list update or a CRC check
+	uint64_t Sorts;				// path selections (sorting network / quickselect)
+	uint64_t Allocations;		// heap allocations during calls (plans, output lists, encoder outputs, hashes, keys)
+	uint64_t FrozenLeaves;		// frozen bit decisions, per path
+	uint64_t InfoLeaves;		// information bit decisions, per path (before forking)
+	uint64_t Time[PLC_NumberOfStages]; // per stage: TSC cycles on x86, nanoseconds elsewhere
+} PLC_Stats;
+
+/// @brief Reads the statistics of a context.
+/// @param Context Context, nullptr -> default context (PLC_Init).
+/// @return True on success, false if the library is built without PLC_ENABLE_STATS (-> Stats is zeroed).
+bool PLC_GetStats(PLC_Context const*const Context, PLC_Stats *const Stats);
+
+/// @brief Resets the statistics of a context, nullptr -> default context (PLC_Init).
+void PLC_ResetStats(PLC_Context *const Context);
+
+/// @brief Initializes this module (-> configures the default context used by the functions without context parameter).
 /// @param N Word length (in bits).
 /// @param K Codeword length / raw key length (in bits).
 /// @param NumberOfDecoders Number of decoders (for list decoding).
-void PLC_Init(uint16_t const N, uint16_t const K, uint8_t const NumberOfDecoders);
+void PLC_Init(uint32_t const N, uint32_t const K, uint8_t const NumberOfDecoders);
 
 /// @brief Tries to reconstruct the key from the given SRAM PUF fingerprint.
 /// @param Fingerprint SRAM fingerprint.
 /// @param FingerprintLength Length of fingerprint (in bytes).
 /// @param HelperData Helper data - values of frozen bits.
-/// @param HelperDataSize Helper data length (in bytes).
-/// @param FrozenBitMask Mask, which indicates which bits are frozen.
+/// @param HelperDataSize Helper data length (in bytes), at least PLC_GetHelperDataSize (as written by PLC_Enroll).
+/// @param FrozenBitMask Mask, which indicates which bits are frozen. Has to contain exactly K information (non-frozen) bits.
 /// @param FrozenBitMaskLength Mask length (in bytes).
 /// @param ValidationHash Hash to determine the correct output of the multiple possibilities.
-/// @param ValidationHashLength Length of hash (in bytes).
-/// @return Reproduced key, with length OutputKeyLengthByte, on success, nullptr otherwise.
-uint8_t* PLC_Reproduce(uint8_t const*const Fingerprint, uint16_t const _FingerprintLength, 
-                       uint8_t const*const HelperData, uint16_t const HelperDataSize,
-                       uint8_t const*const FrozenBitMask, uint16_t const _FrozenBitMaskLength,
+/// @param ValidationHashLength Length of hash (in bytes), has to be the key length (PLC_GetKeyLength).
+/// @return Reproduced key, with length PLC_GetKeyLength (default: OutputKeyLengthByte), on success, nullptr otherwise.
+/// When CRC aided decoding is configured (PLC_SetCRC), the helper data has to contain the CRC values (see PLC_ComputeCRC) and only the validated winner is hashed.
+uint8_t* PLC_Reproduce(uint8_t const*const Fingerprint, uint32_t const _FingerprintLength, 
+                       uint8_t const*const HelperData, uint32_t const HelperDataSize,
+                       uint8_t const*const FrozenBitMask, uint32_t const _FrozenBitMaskLength,
                        uint8_t const*const ValidationHash, uint16_t const _ValidationHashLength);
 
+/// @brief Same as PLC_Reproduce, but uses the given context instead of the default one.
+uint8_t* PLC_Reproduce_Ctx(PLC_Context *const Context,
+                           uint8_t const*const Fingerprint, uint32_t const _FingerprintLength, 
+                           uint8_t const*const HelperData, uint32_t const HelperDataSize,
+                           uint8_t const*const FrozenBitMask, uint32_t const _FrozenBitMaskLength,
+                           uint8_t const*const ValidationHash, uint16_t const _ValidationHashLength);
+
+/// @brief Tries to reconstruct the key from multiple readouts of the same SRAM PUF (soft decision decoding).
+/// The reliability of every cell is derived from how often it flips between the readouts.
+/// @param Fingerprints Array of SRAM fingerprints (readouts).
+/// @param NumberOfReadouts Number of fingerprints.
+/// @param FingerprintLength Length of each fingerprint (in bytes).
+/// For all other parameters and the return value see PLC_Reproduce.
+uint8_t* PLC_Reproduce_MultiReadout(PLC_Context *const Context,
+                                    uint8_t const*const*const Fingerprints, uint8_t const NumberOfReadouts, uint32_t const FingerprintLength,
+                                    uint8_t const*const HelperData, uint32_t const HelperDataSize,
+                                    uint8_t const*const FrozenBitMask, uint32_t const _FrozenBitMaskLength,
+                                    uint8_t const*const ValidationHash, uint16_t const _ValidationHashLength);
+
+/// @brief Same as PLC_Reproduce_Ctx, but writes the key into a caller provided buffer. No heap allocations (once the plan for the mask is cached, see PLC_GetPlan):
+/// intermediate values live in the context's workspace, the hash state on the stack.
+/// @param Context Context, nullptr -> default context (PLC_Init).
+/// @param Key Output, at least PLC_GetKeyLength bytes.
+/// @param KeyLength Length of the key buffer (in bytes).
+/// @return True on success, false otherwise.
+bool PLC_Reproduce_Into(PLC_Context *const Context,
+                        uint8_t const*const Fingerprint, uint32_t const _FingerprintLength,
+                        uint8_t const*const HelperData, uint32_t const HelperDataSize,
+                        uint8_t const*const FrozenBitMask, uint32_t const _FrozenBitMaskLength,
+                        uint8_t const*const ValidationHash, uint16_t const _ValidationHashLength,
+                        uint8_t *const Key, uint16_t const KeyLength);
+
+/// @brief Same as PLC_Reproduce_MultiReadout, but writes the key into a caller provided buffer (see PLC_Reproduce_Into).
+bool PLC_Reproduce_MultiReadout_Into(PLC_Context *const Context,
+                                     uint8_t const*const*const Fingerprints, uint8_t const NumberOfReadouts, uint32_t const FingerprintLength,
+                                     uint8_t const*const HelperData, uint32_t const HelperDataSize,
+                                     uint8_t const*const FrozenBitMask, uint32_t const _FrozenBitMaskLength,
+                                     uint8_t const*const ValidationHash, uint16_t const _ValidationHashLength,
+                                     uint8_t *const Key, uint16_t const KeyLength);
+
+/// @brief Size of the helper data (in bytes): values of the N - K frozen bits of the code word, followed by the CRC values (2 bytes each) if CRC aided decoding is configured.
+/// @param Context Context, nullptr -> default context (PLC_Init).
+uint32_t PLC_GetHelperDataSize(PLC_Context const*const Context);
+
+/// @brief Enrollment (counterpart of PLC_Reproduce): creates the helper data, the validation hash and the key for a fingerprint.
+/// The fingerprint bits at the non-frozen positions are the plain text (systematic code, PLC_SetSystematic: the code word) -> key = hash of the non-frozen bits of the code word,
+/// helper data = frozen bits of the code word (+ CRC values, see PLC_SetCRC), validation hash = hash of the plain text (hash provider of the context, default: SHA-1). Uses the context's workspace (no heap allocations).
+/// @param Context Context, nullptr -> default context (PLC_Init). Reproduce with the same code parameters, CRC configuration and mode.
+/// @param FrozenBitMask Mask with exactly K information (non-frozen) bits (-> N - K helper data bits).
+/// @param HelperData Output, at least PLC_GetHelperDataSize bytes.
+/// @param ValidationHash Output, PLC_GetKeyLength bytes.
+/// @param Key Output, at least PLC_GetKeyLength bytes.
+/// @return True on success, false on error (invalid parameters, hash failed, mask not suited for systematic encoding).
+bool PLC_Enroll(PLC_Context *const Context,
+                uint8_t const*const Fingerprint, uint32_t const FingerprintLength,
+                uint8_t const*const FrozenBitMask, uint32_t const FrozenBitMaskLength,
+                uint8_t *const HelperData, uint32_t const HelperDataSize,
+                uint8_t *const ValidationHash, uint16_t const ValidationHashLength,
+                uint8_t *const Key, uint16_t const KeyLength);
+
 /// @brief Encodes a given plain text. The frozen bit mask (reliability sequence) has to be applied beforehand.
 /// @param Input Plain text to encode. Only first N bits are used.
 /// @param InputLength Length of input (in bytes).
 /// @return Encoded word, with length N. Nullptr on error.
-uint8_t* PLC_Encode(uint8_t const*const Input, uint16_t const InputLength);
+uint8_t* PLC_Encode(uint8_t const*const Input, uint32_t const InputLength);
+
+/// @brief Same as PLC_Encode, but uses the given context instead of the default one.
+uint8_t* PLC_Encode_Ctx(PLC_Context const*const Context, uint8_t const*const Input, uint32_t const InputLength);
+
+/// @brief Encodes a given plain text in place (caller provided buffer, no allocation). The frozen bit mask (reliability sequence) has to be applied beforehand.
+/// @param Values Plain text to encode, is overwritten by the encoded word. Only first N bits are used.
+/// @param ValuesLength Length of values (in bytes).
+/// @return True on success, false on error.
+bool PLC_Encode_InPlace(PLC_Context const*const Context, uint8_t *const Values, uint32_t const ValuesLength);
+
+/// @brief Encodes a given plain text into a caller provided buffer (no allocation). The frozen bit mask (reliability sequence) has to be applied beforehand.
+/// @param Context Context, nullptr -> default context (PLC_Init).
+/// @param Input Plain text to encode. Only first N bits are used.
+/// @param Output Encoded word (N bits), may be the input itself.
+/// @param OutputLength Length of output (in bytes).
+/// @return True on success, false on error.
+bool PLC_Encode_Into(PLC_Context const*const Context, uint8_t const*const Input, uint32_t const InputLength, uint8_t *const Output, uint32_t const OutputLength);
+
+/// @brief Systematic encoder: the code word x = u * F^(xn) (frozen bits of u are 0) carries the given information bits unchanged at its non-frozen positions.
+/// @param Context Context, nullptr -> default context (PLC_Init).
+/// @param Input Information bits at the non-frozen positions (frozen positions are ignored). Only first N bits are used.
+/// @param FrozenBitMask Mask, which indicates which bits are frozen. Its information set has to be domination contiguous (true for masks of the most reliable bit channels).
+/// @param Output Code word (N bits), must not be the input. The plain text is PLC_Encode_InPlace(Output).
+/// @param OutputLength Length of output (in bytes).
+/// @return True on success, false on error (or if the mask is not suited for systematic encoding).
+bool PLC_Encode_Systematic(PLC_Context const*const Context, uint8_t const*const Input, uint32_t const InputLength,
+                           uint8_t const*const FrozenBitMask, uint32_t const FrozenBitMaskLength, uint8_t *const Output, uint32_t const OutputLength);
                    
 /// @brief Successive cancellation list decoder. Decodes a given encoded word.
 /// @param Input Encoded word. Only first N bits are used.
@@ -50,7 +295,86 @@ uint8_t* PLC_Encode(uint8_t const*const Input, uint16_t const InputLength);
 /// @param FrozenBitMask Mask, which indicates which bits are frozen (-> usually indicated by a reliability sequence).
 /// @param FrozenBitMaskLength Mask length (in bytes).
 /// @return A list (of length NumberOfDecoders) of possible decoded plain texts (with length N). Nullptr on error.
-uint8_t **PLC_SCL_Decode(uint8_t const*const Input, uint16_t const InputLength, 
-                         uint8_t const*const FrozenBitMask, uint16_t const FrozenBitMaskLength);
+uint8_t **PLC_SCL_Decode(uint8_t const*const Input, uint32_t const InputLength, 
+                         uint8_t const*const FrozenBitMask, uint32_t const FrozenBitMaskLength);
+
+/// @brief Same as PLC_SCL_Decode, but uses the given context instead of the default one.
+uint8_t **PLC_SCL_Decode_Ctx(PLC_Context *const Context,
+                             uint8_t const*const Input, uint32_t const InputLength, 
+                             uint8_t const*const FrozenBitMask, uint32_t const FrozenBitMaskLength);
+
+/// @brief Successive cancellation list decoder for soft input. Decodes a given word of quantized LLRs (Log Likelihood Ratios).
+/// @param LLRs One LLR per bit: positive -> bit is more likely 0, negative -> bit is more likely 1, magnitude -> reliability. Only first N values are used.
+///             Converted to the LLR precision of the build (PLC_LLR_INT8 -> saturated to +-127).
+/// @param NumberOfLLRs Number of LLRs.
+/// @param FrozenBitMask Mask, which indicates which bits are frozen (-> usually indicated by a reliability sequence).
+/// @param FrozenBitMaskLength Mask length (in bytes).
+/// @return A list (of length NumberOfDecoders) of possible decoded plain texts (with length N). Nullptr on error.
+uint8_t **PLC_SCL_Decode_Soft(PLC_Context *const Context,
+                              int16_t const*const LLRs, uint32_t const NumberOfLLRs, 
+                              uint8_t const*const FrozenBitMask, uint32_t const FrozenBitMaskLength);
+
+/// @brief Path metric of a decoded candidate: sum of the LLR magnitudes contradicting its decisions, relative to the best path of the list (lower is better).
+/// Build your code with the same LLR precision define as the library (PLC_LLR_FLOAT -> float, else int32).
+#ifdef PLC_LLR_FLOAT
+	typedef float PLC_PathMetric;
+#else
+	typedef int32_t PLC_PathMetric;
+#endif
+
+/// @brief Same as PLC_SCL_Decode_Ctx, but writes the list into a caller provided buffer. No heap allocations (once the plan for the mask is cached, see PLC_GetPlan).
+/// @param Context Context, nullptr -> default context (PLC_Init).
+/// @param Outputs Output buffer of NumberOfDecoders * NBytes bytes: path p starts at p * NBytes, unused paths are zero.
+/// @param OutputsLength Length of the output buffer (in bytes).
+/// @param PathMetrics Output (optional): NumberOfDecoders path metrics, unused paths are 0.
+/// @return Number of paths, 0 on error.
+uint8_t PLC_SCL_Decode_Into(PLC_Context *const Context,
+                            uint8_t const*const Input, uint32_t const InputLength,
+                            uint8_t const*const FrozenBitMask, uint32_t const FrozenBitMaskLength,
+                            uint8_t *const Outputs, uint32_t const OutputsLength, PLC_PathMetric *const PathMetrics);
+
+/// @brief Same as PLC_SCL_Decode_Into, but returns only the K information bits of every path (non-frozen positions in index order, packed), instead of the full plain text.
+/// Systematic code (PLC_SetSystematic): the information bits are taken from the code word estimates.
+/// The frozen bit mask has to contain exactly K information bits.
+/// @param InfoBits Output buffer of NumberOfDecoders * ((K + 7) / 8) bytes: path p starts at p * ((K + 7) / 8), unused paths are zero.
+/// @param InfoBitsLength Length of the output buffer (in bytes).
+/// @return Number of paths, 0 on error.
+uint8_t PLC_SCL_Decode_InfoBits(PLC_Context *const Context,
+                                uint8_t const*const Input, uint32_t const InputLength,
+                                uint8_t const*const FrozenBitMask, uint32_t const FrozenBitMaskLength,
+                                uint8_t *const InfoBits, uint32_t const InfoBitsLength, PLC_PathMetric *const PathMetrics);
+
+/// @brief Scratch memory for decoding multiple codewords (frames) in lockstep (see PLC_SCL_Decode_Batch), sized once from the context's code parameters and the batch size.
+typedef struct PLC_Batch PLC_Batch;
+
+/// @brief Creates a batch for the given context's code parameters.
+/// @param BatchSize Max. number of frames decoded at once. Multiples of 16 make best use of the SIMD kernels.
+/// @return New batch (free with PLC_DeleteBatch). Nullptr on error.
+PLC_Batch* PLC_CreateBatch(PLC_Context const*const Context, uint16_t const BatchSize);
+
+/// @brief Deletes a batch -> frees memory.
+void PLC_DeleteBatch(PLC_Batch* Batch);
+
+/// @brief Successive cancellation list decoder for multiple codewords sharing one frozen bit mask. The frames are decoded in lockstep with frame interleaved LLRs,
+/// every f / g / combine step processes all frames at once (-> SIMD is used even in the lower tree layers). Each frame keeps its own list of paths and path metrics,
+/// the output of every frame is the same as from PLC_SCL_Decode_Ctx. Node specializations and CRC are not used.
+/// @param Inputs NumberOfFrames codewords, NBytes each, one after another.
+/// @param NumberOfFrames Number of codewords (max. batch size).
+/// @param Outputs Output buffer of NumberOfFrames * NumberOfDecoders * NBytes bytes: path p of frame f starts at (f * NumberOfDecoders + p) * NBytes, unused paths are zero.
+/// @param NumberOfPaths Output (optional): number of paths per frame.
+/// @return True on success, false on error.
+bool PLC_SCL_Decode_Batch(PLC_Context *const Context, PLC_Batch *const Batch,
+                          uint8_t const*const Inputs, uint16_t const NumberOfFrames,
+                          uint8_t const*const FrozenBitMask, uint32_t const FrozenBitMaskLength,
+                          uint8_t *const Outputs, uint8_t *const NumberOfPaths);
+
+/// @brief CRC aided successive cancellation list decoder (see PLC_SetCRC). Paths failing a CRC check are dropped during decoding.
+/// @param CRCValues Expected CRC value for every checkpoint.
+/// @param NumberOfCRCValues Number of CRC values (has to match the number of checkpoints).
+/// @return Decoded plain text (with length N) of the path with the lowest path metric, which passed all CRC checks. Nullptr if all paths failed or on error.
+uint8_t *PLC_SCL_Decode_CRC(PLC_Context *const Context,
+                            uint8_t const*const Input, uint32_t const InputLength, 
+                            uint8_t const*const FrozenBitMask, uint32_t const FrozenBitMaskLength,
+                            uint16_t const*const CRCValues, uint8_t const NumberOfCRCValues);
 
 #endif
\ No newline at end of file
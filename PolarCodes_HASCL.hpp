@@ -0,0 +1,492 @@
+#ifndef PLC_HASCL_HPP
+#define PLC_HASCL_HPP
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+/*  Header-only C++17 version of the encoder + successive cancellation list decoder, specialized at compile time for a fixed configuration.
+*   N, L and the LLR type are template parameters -> all tree offsets are constants, all storage is std::array (no heap), the tree recursion is unrolled.
+*   The frozen bit mask can be a compile-time parameter as well (see SclDecoder), the frozen / information decision of every leaf is then resolved by the compiler.
+*
+*   Bit order, frozen bit mask and output list are the same as in PolarCodes_HASCL.h: the output of SclDecoder::Decode is bit-exact to PLC_SCL_Decode
+*   (same N, K, L, LLR precision of the C build: int16_t -> default, int8_t -> PLC_LLR_INT8, float -> PLC_LLR_FLOAT).
+*/
+
+namespace polar
+{
+	namespace detail
+	{
+		constexpr std::size_t Log2(std::size_t const Value)
+		{
+			return Value <= 1 ? 0 : 1 + Log2(Value / 2);
+		}
+
+		inline std::uint8_t GetBit(std::uint8_t const* const Buffer, std::size_t const Index)
+		{
+			return (Buffer[Index / 8] >> (Index % 8)) & 0x01;
+		}
+
+		inline void SetBit(std::uint8_t* const Buffer, std::size_t const Index, std::uint8_t const Bit)
+		{
+			Buffer[Index / 8] = (std::uint8_t)((Buffer[Index / 8] & ~(1u << (Index % 8))) | ((Bit & 0x01u) << (Index % 8)));
+		}
+	}
+
+	/// @brief Polar encoder (x = u * F^{\otimes n}) for a fixed word length N (in bits, power of 2, >= 8).
+	template<std::size_t N>
+	class Encoder
+	{
+		static_assert(N >= 8 && (N & (N - 1)) == 0, "N has to be a power of 2 (and at least one byte)");
+
+	public:
+		static constexpr std::size_t n = detail::Log2(N);
+		static constexpr std::size_t NBytes = N / 8;
+		using Word = std::array<std::uint8_t, NBytes>;
+
+		/// @brief Encodes a given plain text in place. The frozen bit mask has to be applied beforehand.
+		static void EncodeInPlace(Word& Values)
+		{
+			//stages within a byte: every bit with (index & m) == 0 is XORed with the bit m positions higher
+			constexpr std::uint8_t StageMasks[3] = { 0x55, 0x33, 0x0F };
+			for(std::size_t i = 0; i < NBytes; i++)
+			{
+				std::uint8_t Byte = Values[i];
+				for(std::size_t s = 0; s < 3; s++)
+				{
+					Byte ^= (std::uint8_t)((Byte >> (1u << s)) & StageMasks[s]);
+				}
+				Values[i] = Byte;
+			}
+
+			//stages across bytes
+			for(std::size_t mBytes = 1; mBytes < NBytes; mBytes *= 2)
+			{
+				for(std::size_t i = 0; i < NBytes; i += 2 * mBytes)
+				{
+					for(std::size_t j = 0; j < mBytes; j++) Values[i + j] ^= Values[i + j + mBytes];
+				}
+			}
+		}
+
+		/// @brief Encodes a given plain text. The frozen bit mask has to be applied beforehand.
+		/// @return Encoded word.
+		static Word Encode(Word const& Input)
+		{
+			Word Values = Input;
+			EncodeInPlace(Values);
+			return Values;
+		}
+	};
+
+	/// @brief Successive cancellation list decoder for a fixed word length N (in bits, power of 2, >= 8), list size L and LLR type (int8_t, int16_t or float).
+	/// @tparam FrozenMask void -> the frozen bit mask is passed at runtime (Decode(Input, FrozenBitMask, Output)).
+	/// Otherwise a type with a member "static constexpr std::array<std::uint8_t, N / 8> Value" holding the mask (0 -> frozen, 1 -> information bit),
+	/// the decoder is then compiled for this mask (Decode(Input, Output)).
+	/// All scratch memory is part of the object (about L * 5 * N bytes for int16_t) -> allocate large decoders statically or on the heap.
+	template<std::size_t N, std::size_t L, typename LLR_t = std::int16_t, typename FrozenMask = void>
+	class SclDecoder
+	{
+		static_assert(N >= 8 && (N & (N - 1)) == 0, "N has to be a power of 2 (and at least one byte)");
+		static_assert(L >= 1 && L <= 255, "L has to be in 1 ... 255");
+		static_assert(std::is_same<LLR_t, std::int8_t>::value || std::is_same<LLR_t, std::int16_t>::value || std::is_same<LLR_t, float>::value,
+					  "LLR_t has to be int8_t, int16_t or float");
+
+	public:
+		static constexpr std::size_t n = detail::Log2(N);
+		static constexpr std::size_t NBytes = N / 8;
+		using Word = std::array<std::uint8_t, NBytes>;
+		using List = std::array<Word, L>;
+		using LLRs = std::array<LLR_t, N>;
+
+		/// @brief Decodes a given (hard decision) word with the frozen bit mask given at runtime.
+		/// @param Output List of possible decoded plain texts, ordered as by PLC_SCL_Decode. Entries behind the return value are zeroed.
+		/// @return Number of decoded plain texts (list entries used).
+		template<typename Mask = FrozenMask, typename std::enable_if<std::is_void<Mask>::value, int>::type = 0>
+		std::size_t Decode(Word const& Input, Word const& FrozenBitMask, List& Output)
+		{
+			SetHardInput(Input);
+			return DecodeRuntime(FrozenBitMask, Output);
+		}
+
+		/// @brief Decodes a given word of LLRs (positive -> bit is more likely 0) with the frozen bit mask given at runtime.
+		/// @return Number of decoded plain texts (list entries used).
+		template<typename Mask = FrozenMask, typename std::enable_if<std::is_void<Mask>::value, int>::type = 0>
+		std::size_t DecodeSoft(LLRs const& Input, Word const& FrozenBitMask, List& Output)
+		{
+			std::copy(Input.begin(), Input.end(), Slots[0].LLR.begin());
+			return DecodeRuntime(FrozenBitMask, Output);
+		}
+
+		/// @brief Decodes a given (hard decision) word with the compile-time frozen bit mask.
+		/// @return Number of decoded plain texts (list entries used).
+		template<typename Mask = FrozenMask, typename std::enable_if<!std::is_void<Mask>::value, int>::type = 0>
+		std::size_t Decode(Word const& Input, List& Output)
+		{
+			SetHardInput(Input);
+			return DecodeStatic(Output);
+		}
+
+		/// @brief Decodes a given word of LLRs (positive -> bit is more likely 0) with the compile-time frozen bit mask.
+		/// @return Number of decoded plain texts (list entries used).
+		template<typename Mask = FrozenMask, typename std::enable_if<!std::is_void<Mask>::value, int>::type = 0>
+		std::size_t DecodeSoft(LLRs const& Input, List& Output)
+		{
+			std::copy(Input.begin(), Input.end(), Slots[0].LLR.begin());
+			return DecodeStatic(Output);
+		}
+
+	private:
+		static constexpr bool IsFloat = std::is_floating_point<LLR_t>::value;
+		using Sum_t = typename std::conditional<IsFloat, float, std::int32_t>::type; // intermediate of the g-function
+		using PathMetric_t = typename std::conditional<IsFloat, float, std::int32_t>::type;
+
+		// --- TREE LAYOUT --- //
+		// Only one node per depth is processed at a time -> per path, depth d holds the LLRs of the current node (N >> d values)
+		// and the decisions of the current node's children (depth d + 1: left child | right child, N >> d bits, one byte each).
+
+		static constexpr std::size_t Size(std::size_t const Depth) { return N >> Depth; }
+		static constexpr std::size_t LLROffset(std::size_t const Depth) { return 2 * N - 2 * Size(Depth); }
+		static constexpr std::size_t BetaOffset(std::size_t const Depth) { return 2 * N - 2 * Size(Depth - 1); } // depth >= 1
+
+		struct Path
+		{
+			std::array<LLR_t, 2 * N - 1> LLR;
+			std::array<std::uint8_t, 2 * N - 2> Beta;
+			Word PlainText;
+			PathMetric_t Metric;
+		};
+
+		struct Candidate
+		{
+			PathMetric_t Metric;
+			std::uint8_t Decision;
+		};
+
+		std::array<Path, L> Slots;
+		std::array<std::uint8_t, L> Paths;			// list position -> slot
+		std::array<std::uint8_t, L> FreeSlots;
+		std::size_t NumberFreeSlots = 0;
+		std::size_t NumberOfPaths = 0;
+		std::array<Candidate, 2 * L> Candidates;
+		std::array<std::uint64_t, 2 * L> Keys;
+		std::array<std::uint64_t, L> Copies;
+
+		static constexpr std::uint8_t NoPath = 0xFF;
+
+		// --- KERNELS (same arithmetic as the scalar reference kernels of PolarCodes_Kernels.c) --- //
+
+		static LLR_t Saturate(Sum_t const Value)
+		{
+			if constexpr(IsFloat) return Value;
+			else
+			{
+				constexpr Sum_t Max = std::numeric_limits<LLR_t>::max(), Min = std::numeric_limits<LLR_t>::min();
+				return (LLR_t)(Value > Max ? Max : (Value < Min ? Min : Value));
+			}
+		}
+
+		/// @brief Saturating absolute value.
+		static LLR_t Magnitude(LLR_t const Value)
+		{
+			if constexpr(IsFloat) return std::fabs(Value);
+			else return Saturate(Value < 0 ? -(Sum_t)Value : Value);
+		}
+
+		static bool IsNegative(LLR_t const Value)
+		{
+			if constexpr(IsFloat) return std::signbit(Value);
+			else return Value < 0;
+		}
+
+		static LLR_t f(LLR_t const a, LLR_t const b)
+		{
+			LLR_t const a_abs = Magnitude(a);
+			LLR_t const b_abs = Magnitude(b);
+			LLR_t const min = a_abs < b_abs ? a_abs : b_abs;
+
+			return IsNegative(a) != IsNegative(b) ? (LLR_t)-min : min;
+		}
+
+		static LLR_t g(LLR_t const a, LLR_t const b, std::uint8_t const c)
+		{
+			return Saturate(c ? (Sum_t)b - a : (Sum_t)b + a);
+		}
+
+		static PathMetric_t GetMagnitude(LLR_t const LLR)
+		{
+			if constexpr(IsFloat) return std::fabs(LLR);
+			else return LLR < 0 ? -(PathMetric_t)LLR : LLR;
+		}
+
+		static PathMetric_t AddMetrics(PathMetric_t const a, PathMetric_t const b)
+		{
+			if constexpr(IsFloat) return a + b;
+			else return b > std::numeric_limits<PathMetric_t>::max() - a ? std::numeric_limits<PathMetric_t>::max() : a + b;
+		}
+
+		/// @brief Selection key: path metric (order preserving as unsigned) in the upper half, candidate index in the lower half (-> unique, ties broken by index).
+		static std::uint64_t GetSelectionKey(PathMetric_t const Metric, std::size_t const CandidateIndex)
+		{
+			std::uint32_t Bits;
+			if constexpr(IsFloat) std::memcpy(&Bits, &Metric, sizeof(Bits)); // path metrics are >= 0 -> bit patterns have the same order
+			else Bits = (std::uint32_t)Metric ^ 0x80000000u;
+			return ((std::uint64_t)Bits << 32) | CandidateIndex;
+		}
+
+		// --- STEPS --- //
+
+		void SetHardInput(Word const& Input)
+		{
+			for(std::size_t i = 0; i < N; i++) Slots[0].LLR[i] = detail::GetBit(Input.data(), i) ? (LLR_t)-1 : (LLR_t)1;
+		}
+
+		void Reset()
+		{
+			Paths.fill(NoPath);
+			Paths[0] = 0;
+			NumberOfPaths = 1;
+			NumberFreeSlots = 0;
+			for(std::size_t i = L; i > 1; i--) FreeSlots[NumberFreeSlots++] = (std::uint8_t)(i - 1);
+
+			Slots[0].Metric = 0;
+			Slots[0].PlainText.fill(0);
+		}
+
+		/// @brief Left child LLRs of the current node at the given depth.
+		template<std::size_t Depth>
+		void StepF()
+		{
+			constexpr std::size_t Half = Size(Depth) / 2;
+			for(std::size_t p = 0; p < NumberOfPaths; p++)
+			{
+				Path& Current = Slots[Paths[p]];
+				LLR_t const* const a = Current.LLR.data() + LLROffset(Depth);
+				LLR_t* const Dst = Current.LLR.data() + LLROffset(Depth + 1);
+				for(std::size_t j = 0; j < Half; j++) Dst[j] = f(a[j], a[j + Half]);
+			}
+		}
+
+		/// @brief Right child LLRs of the current node at the given depth.
+		template<std::size_t Depth>
+		void StepG()
+		{
+			constexpr std::size_t Half = Size(Depth) / 2;
+			for(std::size_t p = 0; p < NumberOfPaths; p++)
+			{
+				Path& Current = Slots[Paths[p]];
+				LLR_t const* const a = Current.LLR.data() + LLROffset(Depth);
+				std::uint8_t const* const Left = Current.Beta.data() + BetaOffset(Depth + 1);
+				LLR_t* const Dst = Current.LLR.data() + LLROffset(Depth + 1);
+				for(std::size_t j = 0; j < Half; j++) Dst[j] = g(a[j], a[j + Half], Left[j]);
+			}
+		}
+
+		/// @brief Decisions of the current node at the given depth (-> its half of the parent's row) from its children's decisions.
+		template<std::size_t Depth>
+		void StepCombine(std::size_t const Node)
+		{
+			constexpr std::size_t Half = Size(Depth) / 2;
+			for(std::size_t p = 0; p < NumberOfPaths; p++)
+			{
+				Path& Current = Slots[Paths[p]];
+				std::uint8_t const* const Children = Current.Beta.data() + BetaOffset(Depth + 1);
+				std::uint8_t* const Dst = Current.Beta.data() + BetaOffset(Depth) + (Node & 1) * Size(Depth);
+				for(std::size_t j = 0; j < Half; j++)
+				{
+					Dst[j] = Children[j] ^ Children[j + Half];
+					Dst[j + Half] = Children[j + Half];
+				}
+			}
+		}
+
+		void SetDecision(Path& Current, std::size_t const Leaf, std::uint8_t const Decision)
+		{
+			Current.Beta[BetaOffset(n) + (Leaf & 1)] = Decision;
+			detail::SetBit(Current.PlainText.data(), Leaf, Decision);
+		}
+
+		void FrozenLeaf(std::size_t const Leaf)
+		{
+			for(std::size_t p = 0; p < NumberOfPaths; p++)
+			{
+				Path& Current = Slots[Paths[p]];
+				LLR_t const LLR = Current.LLR[LLROffset(n)];
+				SetDecision(Current, Leaf, 0); // bit is frozen -> value is set to 0
+				if(LLR < 0) Current.Metric = AddMetrics(Current.Metric, GetMagnitude(LLR));
+			}
+		}
+
+		/// @brief Copies the parts of a path the remaining traversal reads: per ancestor of the leaf its LLRs if the leaf is in its left subtree (-> g pending),
+		/// else its left child's decisions (-> combine pending, unless the ancestor is on the rightmost path), and the plain text.
+		void CopyPath(Path const& Source, Path& Destination, std::size_t const Leaf)
+		{
+			bool OnRightmostPath = true;
+			for(std::size_t Depth = 0; Depth < n; Depth++)
+			{
+				std::size_t const Half = Size(Depth) / 2;
+				if((Leaf & Half) == 0)
+				{
+					OnRightmostPath = false;
+					std::copy_n(Source.LLR.begin() + LLROffset(Depth), 2 * Half, Destination.LLR.begin() + LLROffset(Depth));
+				}
+				else if(!OnRightmostPath)
+				{
+					std::copy_n(Source.Beta.begin() + BetaOffset(Depth + 1), Half, Destination.Beta.begin() + BetaOffset(Depth + 1));
+				}
+			}
+			Destination.PlainText = Source.PlainText;
+		}
+
+		/// @brief List update at an information bit, same selection as ForkDecoders in PolarCodes_HASCL.c (-> same list order):
+		/// the L candidates with the lowest path metric survive (ties -> lower candidate index), a path with both candidates surviving keeps the better one,
+		/// the other one is copied into the lowest free list position, worst candidate first.
+		void InfoLeaf(std::size_t const Leaf)
+		{
+			std::size_t const Count = NumberOfPaths;
+			for(std::size_t p = 0; p < Count; p++)
+			{
+				Path const& Current = Slots[Paths[p]];
+				LLR_t const LLR = Current.LLR[LLROffset(n)];
+				Candidates[p] = { Current.Metric, (std::uint8_t)(LLR < 0 ? 1 : 0) };
+				Candidates[p + Count] = { AddMetrics(Current.Metric, GetMagnitude(LLR)), (std::uint8_t)(LLR >= 0 ? 1 : 0) };
+			}
+
+			std::uint64_t Threshold = UINT64_MAX;
+			if(2 * Count > L)
+			{
+				for(std::size_t i = 0; i < 2 * Count; i++) Keys[i] = GetSelectionKey(Candidates[i].Metric, i);
+				std::nth_element(Keys.begin(), Keys.begin() + (L - 1), Keys.begin() + 2 * Count);
+				Threshold = Keys[L - 1];
+			}
+
+			std::size_t NumberOfCopies = 0;
+			for(std::size_t i = 0; i < Count; i++)
+			{
+				std::uint64_t const Key = GetSelectionKey(Candidates[i].Metric, i);
+				std::uint64_t const InverseKey = GetSelectionKey(Candidates[i + Count].Metric, i + Count);
+				bool const Keep = Key <= Threshold;
+				bool const KeepInverse = InverseKey <= Threshold;
+
+				if(!Keep && !KeepInverse)
+				{
+					FreeSlots[NumberFreeSlots++] = Paths[i];
+					Paths[i] = NoPath;
+					NumberOfPaths--;
+					continue;
+				}
+
+				Candidate const& Assigned = Candidates[Keep && (!KeepInverse || Key < InverseKey) ? i : i + Count];
+				Path& Current = Slots[Paths[i]];
+				SetDecision(Current, Leaf, Assigned.Decision);
+				Current.Metric = Assigned.Metric;
+
+				if(Keep && KeepInverse) // sorted descending
+				{
+					std::uint64_t const CopyKey = Key < InverseKey ? InverseKey : Key;
+					std::size_t j = NumberOfCopies++;
+					for(; j > 0 && Copies[j - 1] < CopyKey; j--) Copies[j] = Copies[j - 1];
+					Copies[j] = CopyKey;
+				}
+			}
+
+			std::size_t FreePosition = 0;
+			for(std::size_t c = 0; c < NumberOfCopies; c++)
+			{
+				std::size_t const CandidateIndex = Copies[c] & 0xFFFF;
+				std::size_t const Source = CandidateIndex < Count ? CandidateIndex : CandidateIndex - Count;
+
+				std::uint8_t const Slot = FreeSlots[--NumberFreeSlots];
+				Path& Copy = Slots[Slot];
+				CopyPath(Slots[Paths[Source]], Copy, Leaf);
+				SetDecision(Copy, Leaf, Candidates[CandidateIndex].Decision);
+				Copy.Metric = Candidates[CandidateIndex].Metric;
+
+				while(Paths[FreePosition] != NoPath) FreePosition++;
+				Paths[FreePosition] = Slot;
+				NumberOfPaths++;
+			}
+
+			//normalize to the lowest path metric
+			PathMetric_t Minimum = Slots[Paths[0]].Metric;
+			for(std::size_t p = 1; p < NumberOfPaths; p++) Minimum = std::min(Minimum, Slots[Paths[p]].Metric);
+			for(std::size_t p = 0; p < NumberOfPaths; p++) Slots[Paths[p]].Metric -= Minimum;
+		}
+
+		// --- TRAVERSAL --- //
+
+		/// @brief Decodes a node (mask given at runtime): f -> left subtree -> g -> right subtree -> combine. Recursion unrolled over the depth.
+		template<std::size_t Depth>
+		void DecodeNode(std::uint8_t const* const FrozenBitMask, std::size_t const Node)
+		{
+			if constexpr(Depth == n)
+			{
+				if(detail::GetBit(FrozenBitMask, Node)) InfoLeaf(Node);
+				else FrozenLeaf(Node);
+			}
+			else
+			{
+				StepF<Depth>();
+				DecodeNode<Depth + 1>(FrozenBitMask, 2 * Node);
+				StepG<Depth>();
+				DecodeNode<Depth + 1>(FrozenBitMask, 2 * Node + 1);
+				if((Node + 1) * Size(Depth) < N) StepCombine<Depth>(Node); // rightmost path: decisions are never read
+			}
+		}
+
+		std::size_t DecodeRuntime(Word const& FrozenBitMask, List& Output)
+		{
+			Reset();
+			DecodeNode<0>(FrozenBitMask.data(), 0);
+			return CreateOutputList(Output);
+		}
+
+		static constexpr bool IsInformationBit(std::size_t const Leaf)
+		{
+			if constexpr(std::is_void<FrozenMask>::value) return false;
+			else return ((FrozenMask::Value[Leaf / 8] >> (Leaf % 8)) & 0x01) != 0;
+		}
+
+		/// @brief Decodes a node (compile-time mask): fully unrolled, leaves are resolved by the compiler.
+		template<std::size_t Depth, std::size_t Node>
+		void DecodeStaticNode()
+		{
+			if constexpr(Depth == n)
+			{
+				if constexpr(IsInformationBit(Node)) InfoLeaf(Node);
+				else FrozenLeaf(Node);
+			}
+			else
+			{
+				StepF<Depth>();
+				DecodeStaticNode<Depth + 1, 2 * Node>();
+				StepG<Depth>();
+				DecodeStaticNode<Depth + 1, 2 * Node + 1>();
+				if constexpr((Node + 1) * Size(Depth) < N) StepCombine<Depth>(Node);
+			}
+		}
+
+		std::size_t DecodeStatic(List& Output)
+		{
+			Reset();
+			DecodeStaticNode<0, 0>();
+			return CreateOutputList(Output);
+		}
+
+		std::size_t CreateOutputList(List& Output) const
+		{
+			for(std::size_t p = 0; p < L; p++)
+			{
+				if(p < NumberOfPaths) Output[p] = Slots[Paths[p]].PlainText;
+				else Output[p].fill(0);
+			}
+			return NumberOfPaths;
+		}
+	};
+}
+
+#endif
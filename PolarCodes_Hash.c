@@ -0,0 +1,479 @@
+#include "PolarCodes_Hash.h"
+#include <stddef.h>
+#include <string.h>
+
+#if !defined(PLC_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#define PLC_X86_SHA
+	#include <immintrin.h>
+	#include <cpuid.h>
+#endif
+#if defined(PLC_ARM_SHA) && (defined(PLC_NO_SIMD) || !(defined(__aarch64__) || defined(__arm__)) || !defined(__ARM_FEATURE_SHA2))
+	#undef PLC_ARM_SHA // opt-in (not built with an ARM compiler yet), only with the crypto extensions
+#endif
+#ifdef PLC_ARM_SHA
+	#include <arm_neon.h>
+#endif
+
+/// @brief Compression function: processes whole 64 byte blocks.
+typedef void (*CompressFunction)(uint32_t *const State, uint8_t const* Blocks, uint32_t NumberOfBlocks);
+
+/// @brief Compression function for two messages at once (same number of blocks).
+typedef void (*Compress2Function)(uint32_t *const State0, uint32_t *const State1, uint8_t const* Blocks0, uint8_t const* Blocks1, uint32_t NumberOfBlocks);
+
+typedef struct
+{
+	uint32_t const* InitialState;
+	uint8_t StateWords;
+	uint8_t DigestLength;
+	CompressFunction Compress;
+	Compress2Function Compress2; // nullptr -> no multi-buffer
+} HashImplementation;
+
+static uint32_t const SHA1_InitialState[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+static uint32_t const SHA1_K[4] = { 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6 };
+
+static uint32_t const SHA256_InitialState[8] = { 0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19 };
+static uint32_t const SHA256_K[64] =
+{
+	0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+	0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+	0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+	0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+	0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+	0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+	0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+	0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+};
+
+// --- HELPERS --- //
+
+static uint32_t LoadBE32(uint8_t const*const Bytes)
+{
+	return ((uint32_t)Bytes[0] << 24) | ((uint32_t)Bytes[1] << 16) | ((uint32_t)Bytes[2] << 8) | (uint32_t)Bytes[3];
+}
+
+static void StoreBE32(uint8_t *const Bytes, uint32_t const Value)
+{
+	Bytes[0] = (uint8_t)(Value >> 24);
+	Bytes[1] = (uint8_t)(Value >> 16);
+	Bytes[2] = (uint8_t)(Value >> 8);
+	Bytes[3] = (uint8_t)Value;
+}
+
+static uint32_t Rotl(uint32_t const Value, uint8_t const Shift)
+{
+	return (Value << Shift) | (Value >> (32 - Shift));
+}
+
+static uint32_t Rotr(uint32_t const Value, uint8_t const Shift)
+{
+	return (Value >> Shift) | (Value << (32 - Shift));
+}
+
+// --- PORTABLE (reference) --- //
+
+static void SHA1Compress_Portable(uint32_t *const State, uint8_t const* Blocks, uint32_t NumberOfBlocks)
+{
+	for(; NumberOfBlocks > 0; NumberOfBlocks--, Blocks += 64)
+	{
+		uint32_t W[80];
+		for(uint8_t t = 0; t < 16; t++) W[t] = LoadBE32(Blocks + 4 * t);
+		for(uint8_t t = 16; t < 80; t++) W[t] = Rotl(W[t - 3] ^ W[t - 8] ^ W[t - 14] ^ W[t - 16], 1);
+
+		uint32_t a = State[0], b = State[1], c = State[2], d = State[3], e = State[4];
+		for(uint8_t t = 0; t < 80; t++)
+		{
+			uint32_t f;
+			if(t < 20) f = (b & c) | (~b & d);
+			else if(t < 40 || t >= 60) f = b ^ c ^ d;
+			else f = (b & c) | (b & d) | (c & d);
+
+			uint32_t const Temp = Rotl(a, 5) + f + e + SHA1_K[t / 20] + W[t];
+			e = d;
+			d = c;
+			c = Rotl(b, 30);
+			b = a;
+			a = Temp;
+		}
+
+		State[0] += a; State[1] += b; State[2] += c; State[3] += d; State[4] += e;
+	}
+}
+
+static void SHA256Compress_Portable(uint32_t *const State, uint8_t const* Blocks, uint32_t NumberOfBlocks)
+{
+	for(; NumberOfBlocks > 0; NumberOfBlocks--, Blocks += 64)
+	{
+		uint32_t W[64];
+		for(uint8_t t = 0; t < 16; t++) W[t] = LoadBE32(Blocks + 4 * t);
+		for(uint8_t t = 16; t < 64; t++)
+		{
+			uint32_t const s0 = Rotr(W[t - 15], 7) ^ Rotr(W[t - 15], 18) ^ (W[t - 15] >> 3);
+			uint32_t const s1 = Rotr(W[t - 2], 17) ^ Rotr(W[t - 2], 19) ^ (W[t - 2] >> 10);
+			W[t] = W[t - 16] + s0 + W[t - 7] + s1;
+		}
+
+		uint32_t a = State[0], b = State[1], c = State[2], d = State[3], e = State[4], f = State[5], g = State[6], h = State[7];
+		for(uint8_t t = 0; t < 64; t++)
+		{
+			uint32_t const S1 = Rotr(e, 6) ^ Rotr(e, 11) ^ Rotr(e, 25);
+			uint32_t const Choice = (e & f) ^ (~e & g);
+			uint32_t const Temp1 = h + S1 + Choice + SHA256_K[t] + W[t];
+			uint32_t const S0 = Rotr(a, 2) ^ Rotr(a, 13) ^ Rotr(a, 22);
+			uint32_t const Majority = (a & b) ^ (a & c) ^ (b & c);
+			uint32_t const Temp2 = S0 + Majority;
+
+			h = g; g = f; f = e;
+			e = d + Temp1;
+			d = c; c = b; b = a;
+			a = Temp1 + Temp2;
+		}
+
+		State[0] += a; State[1] += b; State[2] += c; State[3] += d; State[4] += e; State[5] += f; State[6] += g; State[7] += h;
+	}
+}
+
+static HashImplementation const SHA1_Portable = { SHA1_InitialState, 5, 20, SHA1Compress_Portable, 0 };
+static HashImplementation const SHA256_Portable = { SHA256_InitialState, 8, 32, SHA256Compress_Portable, 0 };
+
+#ifdef PLC_X86_SHA
+
+// --- x86 SHA extensions (4 rounds per instruction, two messages interleaved for multi-buffer) --- //
+
+#define SHA_NI_TARGET __attribute__((target("sha,ssse3,sse4.1")))
+
+/// @brief SHA-1 of 1 or 2 lanes: the lanes are independent -> their instructions interleave and keep the hash unit busy.
+static inline __attribute__((always_inline)) SHA_NI_TARGET
+void SHA1Blocks_SHANI(uint32_t *const*const States, uint8_t const*const*const Blocks, uint32_t const NumberOfBlocks, int const Lanes)
+{
+	__m128i const Mask = _mm_set_epi64x(0x0001020304050607LL, 0x08090A0B0C0D0E0FLL); // big endian words, W[t] in the highest lane
+	__m128i ABCD[2], E0[2];
+	for(int l = 0; l < Lanes; l++)
+	{
+		ABCD[l] = _mm_shuffle_epi32(_mm_loadu_si128((__m128i const*)States[l]), 0x1B);
+		E0[l] = _mm_set_epi32((int)States[l][4], 0, 0, 0);
+	}
+
+	for(uint32_t b = 0; b < NumberOfBlocks; b++)
+	{
+		__m128i SavedABCD[2], SavedE[2], E[2], Messages[2][4];
+		for(int l = 0; l < Lanes; l++)
+		{
+			SavedABCD[l] = ABCD[l];
+			SavedE[l] = E0[l];
+		}
+
+		#pragma GCC unroll 20
+		for(int g = 0; g < 20; g++)
+		{
+			for(int l = 0; l < Lanes; l++)
+			{
+				__m128i *const M = Messages[l];
+				if(g < 4) M[g] = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)(Blocks[l] + 64 * b + 16 * g)), Mask);
+				else M[g % 4] = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(M[g % 4], M[(g + 1) % 4]), M[(g + 2) % 4]), M[(g + 3) % 4]);
+
+				//E of this group: initial E (first group), else A of the previous group rotated (sha1nexte)
+				__m128i const EW = g == 0 ? _mm_add_epi32(E0[l], M[0]) : _mm_sha1nexte_epu32(E[l], M[g % 4]);
+				E[l] = ABCD[l];
+				switch(g / 5)
+				{
+				case 0: ABCD[l] = _mm_sha1rnds4_epu32(ABCD[l], EW, 0); break;
+				case 1: ABCD[l] = _mm_sha1rnds4_epu32(ABCD[l], EW, 1); break;
+				case 2: ABCD[l] = _mm_sha1rnds4_epu32(ABCD[l], EW, 2); break;
+				default: ABCD[l] = _mm_sha1rnds4_epu32(ABCD[l], EW, 3); break;
+				}
+			}
+		}
+
+		for(int l = 0; l < Lanes; l++)
+		{
+			E0[l] = _mm_sha1nexte_epu32(E[l], SavedE[l]);
+			ABCD[l] = _mm_add_epi32(ABCD[l], SavedABCD[l]);
+		}
+	}
+
+	for(int l = 0; l < Lanes; l++)
+	{
+		_mm_storeu_si128((__m128i*)States[l], _mm_shuffle_epi32(ABCD[l], 0x1B));
+		States[l][4] = (uint32_t)_mm_extract_epi32(E0[l], 3);
+	}
+}
+
+/// @brief SHA-256 of 1 or 2 lanes (see SHA1Blocks_SHANI). The state is kept as ABEF / CDGH, as the sha256rnds2 instruction expects it.
+static inline __attribute__((always_inline)) SHA_NI_TARGET
+void SHA256Blocks_SHANI(uint32_t *const*const States, uint8_t const*const*const Blocks, uint32_t const NumberOfBlocks, int const Lanes)
+{
+	__m128i const Mask = _mm_set_epi64x(0x0C0D0E0F08090A0BLL, 0x0405060700010203LL); // big endian words
+	__m128i State0[2], State1[2];
+	for(int l = 0; l < Lanes; l++)
+	{
+		__m128i const CDAB = _mm_shuffle_epi32(_mm_loadu_si128((__m128i const*)States[l]), 0xB1);
+		__m128i const HGFE = _mm_shuffle_epi32(_mm_loadu_si128((__m128i const*)(States[l] + 4)), 0x1B);
+		State0[l] = _mm_alignr_epi8(CDAB, HGFE, 8);		// ABEF
+		State1[l] = _mm_blend_epi16(HGFE, CDAB, 0xF0);	// CDGH
+	}
+
+	for(uint32_t b = 0; b < NumberOfBlocks; b++)
+	{
+		__m128i Saved0[2], Saved1[2], Messages[2][4];
+		for(int l = 0; l < Lanes; l++)
+		{
+			Saved0[l] = State0[l];
+			Saved1[l] = State1[l];
+		}
+
+		#pragma GCC unroll 16
+		for(int g = 0; g < 16; g++)
+		{
+			for(int l = 0; l < Lanes; l++)
+			{
+				__m128i *const M = Messages[l];
+				if(g < 4) M[g] = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)(Blocks[l] + 64 * b + 16 * g)), Mask);
+				else M[g % 4] = _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(M[g % 4], M[(g + 1) % 4]), _mm_alignr_epi8(M[(g + 3) % 4], M[(g + 2) % 4], 4)), M[(g + 3) % 4]);
+
+				__m128i const WK = _mm_add_epi32(M[g % 4], _mm_loadu_si128((__m128i const*)&SHA256_K[4 * g]));
+				State1[l] = _mm_sha256rnds2_epu32(State1[l], State0[l], WK);
+				State0[l] = _mm_sha256rnds2_epu32(State0[l], State1[l], _mm_shuffle_epi32(WK, 0x0E));
+			}
+		}
+
+		for(int l = 0; l < Lanes; l++)
+		{
+			State0[l] = _mm_add_epi32(State0[l], Saved0[l]);
+			State1[l] = _mm_add_epi32(State1[l], Saved1[l]);
+		}
+	}
+
+	for(int l = 0; l < Lanes; l++)
+	{
+		__m128i const FEBA = _mm_shuffle_epi32(State0[l], 0x1B);
+		__m128i const DCHG = _mm_shuffle_epi32(State1[l], 0xB1);
+		_mm_storeu_si128((__m128i*)States[l], _mm_blend_epi16(FEBA, DCHG, 0xF0));			// ABCD
+		_mm_storeu_si128((__m128i*)(States[l] + 4), _mm_alignr_epi8(DCHG, FEBA, 8));	// EFGH
+	}
+}
+
+SHA_NI_TARGET
+static void SHA1Compress_SHANI(uint32_t *const State, uint8_t const* Blocks, uint32_t NumberOfBlocks)
+{
+	uint32_t *const States[1] = { State };
+	uint8_t const*const BlockPointers[1] = { Blocks };
+	SHA1Blocks_SHANI(States, BlockPointers, NumberOfBlocks, 1);
+}
+
+SHA_NI_TARGET
+static void SHA1Compress2_SHANI(uint32_t *const State0, uint32_t *const State1, uint8_t const* Blocks0, uint8_t const* Blocks1, uint32_t NumberOfBlocks)
+{
+	uint32_t *const States[2] = { State0, State1 };
+	uint8_t const*const BlockPointers[2] = { Blocks0, Blocks1 };
+	SHA1Blocks_SHANI(States, BlockPointers, NumberOfBlocks, 2);
+}
+
+SHA_NI_TARGET
+static void SHA256Compress_SHANI(uint32_t *const State, uint8_t const* Blocks, uint32_t NumberOfBlocks)
+{
+	uint32_t *const States[1] = { State };
+	uint8_t const*const BlockPointers[1] = { Blocks };
+	SHA256Blocks_SHANI(States, BlockPointers, NumberOfBlocks, 1);
+}
+
+SHA_NI_TARGET
+static void SHA256Compress2_SHANI(uint32_t *const State0, uint32_t *const State1, uint8_t const* Blocks0, uint8_t const* Blocks1, uint32_t NumberOfBlocks)
+{
+	uint32_t *const States[2] = { State0, State1 };
+	uint8_t const*const BlockPointers[2] = { Blocks0, Blocks1 };
+	SHA256Blocks_SHANI(States, BlockPointers, NumberOfBlocks, 2);
+}
+
+static HashImplementation const SHA1_SHANI = { SHA1_InitialState, 5, 20, SHA1Compress_SHANI, SHA1Compress2_SHANI };
+static HashImplementation const SHA256_SHANI = { SHA256_InitialState, 8, 32, SHA256Compress_SHANI, SHA256Compress2_SHANI };
+
+/// @brief SHA extensions (CPUID leaf 7, EBX bit 29) and the SSE levels used alongside them.
+static bool HasSHAExtensions(void)
+{
+	unsigned int a, b, c, d;
+	if(!__get_cpuid_count(7, 0, &a, &b, &c, &d)) return false;
+	return (b & (1u << 29)) != 0 && __builtin_cpu_supports("ssse3") && __builtin_cpu_supports("sse4.1");
+}
+
+#endif
+
+#ifdef PLC_ARM_SHA
+
+// --- ARMv8 crypto extensions (4 rounds per instruction) --- //
+
+static void SHA1Compress_ARMv8(uint32_t *const State, uint8_t const* Blocks, uint32_t NumberOfBlocks)
+{
+	uint32x4_t ABCD = vld1q_u32(State);
+	uint32_t E = State[4];
+
+	for(; NumberOfBlocks > 0; NumberOfBlocks--, Blocks += 64)
+	{
+		uint32x4_t const SavedABCD = ABCD;
+		uint32_t const SavedE = E;
+		uint32x4_t M[4];
+
+		for(int g = 0; g < 20; g++)
+		{
+			if(g < 4) M[g] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(Blocks + 16 * g)));
+			else M[g % 4] = vsha1su1q_u32(vsha1su0q_u32(M[g % 4], M[(g + 1) % 4], M[(g + 2) % 4]), M[(g + 3) % 4]);
+
+			uint32x4_t const WK = vaddq_u32(M[g % 4], vdupq_n_u32(SHA1_K[g / 5]));
+			uint32_t const NextE = vsha1h_u32(vgetq_lane_u32(ABCD, 0)); // A of this group rotated -> E of the next one
+			switch(g / 5)
+			{
+			case 0: ABCD = vsha1cq_u32(ABCD, E, WK); break;
+			case 2: ABCD = vsha1mq_u32(ABCD, E, WK); break;
+			default: ABCD = vsha1pq_u32(ABCD, E, WK); break;
+			}
+			E = NextE;
+		}
+
+		ABCD = vaddq_u32(ABCD, SavedABCD);
+		E += SavedE;
+	}
+
+	vst1q_u32(State, ABCD);
+	State[4] = E;
+}
+
+static void SHA256Compress_ARMv8(uint32_t *const State, uint8_t const* Blocks, uint32_t NumberOfBlocks)
+{
+	uint32x4_t State0 = vld1q_u32(State);
+	uint32x4_t State1 = vld1q_u32(State + 4);
+
+	for(; NumberOfBlocks > 0; NumberOfBlocks--, Blocks += 64)
+	{
+		uint32x4_t const Saved0 = State0, Saved1 = State1;
+		uint32x4_t M[4];
+
+		for(int g = 0; g < 16; g++)
+		{
+			if(g < 4) M[g] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(Blocks + 16 * g)));
+			else M[g % 4] = vsha256su1q_u32(vsha256su0q_u32(M[g % 4], M[(g + 1) % 4]), M[(g + 2) % 4], M[(g + 3) % 4]);
+
+			uint32x4_t const WK = vaddq_u32(M[g % 4], vld1q_u32(&SHA256_K[4 * g]));
+			uint32x4_t const Previous0 = State0;
+			State0 = vsha256hq_u32(State0, State1, WK);
+			State1 = vsha256h2q_u32(State1, Previous0, WK);
+		}
+
+		State0 = vaddq_u32(State0, Saved0);
+		State1 = vaddq_u32(State1, Saved1);
+	}
+
+	vst1q_u32(State, State0);
+	vst1q_u32(State + 4, State1);
+}
+
+static HashImplementation const SHA1_ARMv8 = { SHA1_InitialState, 5, 20, SHA1Compress_ARMv8, 0 };
+static HashImplementation const SHA256_ARMv8 = { SHA256_InitialState, 8, 32, SHA256Compress_ARMv8, 0 };
+
+#endif
+
+// --- MESSAGES --- //
+
+/// @brief Builds the last block(s) of a message: remaining bytes, 0x80, zeros and the message length in bits (big endian).
+/// @param Tail Output, 128 bytes.
+/// @return Number of tail blocks (1 or 2).
+static uint32_t PadMessage(uint8_t const*const Message, uint32_t const Length, uint8_t *const Tail)
+{
+	uint32_t const Remaining = Length % 64;
+	uint32_t const NumberOfBlocks = Remaining < 56 ? 1 : 2;
+	uint64_t const Bits = (uint64_t)Length * 8;
+
+	memset(Tail, 0, 128);
+	if(Remaining > 0) memcpy(Tail, Message + Length - Remaining, Remaining);
+	Tail[Remaining] = 0x80;
+	for(uint8_t i = 0; i < 8; i++)
+	{
+		Tail[NumberOfBlocks * 64 - 1 - i] = (uint8_t)(Bits >> (8 * i));
+	}
+	return NumberOfBlocks;
+}
+
+static void StoreDigest(HashImplementation const*const Implementation, uint32_t const*const State, uint8_t *const Digest)
+{
+	for(uint8_t i = 0; i < Implementation->DigestLength / 4; i++)
+	{
+		StoreBE32(Digest + 4 * i, State[i]);
+	}
+}
+
+static bool HashMessage(void *const UserData, uint8_t const*const Message, uint32_t const Length, uint8_t *const Digest)
+{
+	HashImplementation const*const Implementation = UserData;
+	uint32_t State[8];
+	uint8_t Tail[128];
+
+	if(Message == 0 && Length > 0) return false;
+
+	memcpy(State, Implementation->InitialState, Implementation->StateWords * sizeof(uint32_t));
+	Implementation->Compress(State, Message, Length / 64);
+	Implementation->Compress(State, Tail, PadMessage(Message, Length, Tail));
+	StoreDigest(Implementation, State, Digest);
+	return true;
+}
+
+#ifdef PLC_X86_SHA // only implementations with an interleaved compression function (Compress2) use it
+
+/// @brief Multi-buffer: hashes the messages pairwise with the interleaved compression function.
+static bool HashMessages(void *const UserData, uint8_t const*const*const Messages, uint16_t const NumberOfMessages, uint32_t const Length, uint8_t *const Digests)
+{
+	HashImplementation const*const Implementation = UserData;
+	uint8_t const DigestLength = Implementation->DigestLength;
+
+	uint16_t i = 0;
+	for(; i + 2 <= NumberOfMessages; i += 2)
+	{
+		uint32_t State0[8], State1[8];
+		uint8_t Tail0[128], Tail1[128];
+
+		if(Messages[i] == 0 || Messages[i + 1] == 0) return false;
+
+		memcpy(State0, Implementation->InitialState, Implementation->StateWords * sizeof(uint32_t));
+		memcpy(State1, Implementation->InitialState, Implementation->StateWords * sizeof(uint32_t));
+		Implementation->Compress2(State0, State1, Messages[i], Messages[i + 1], Length / 64);
+
+		uint32_t const TailBlocks = PadMessage(Messages[i], Length, Tail0);
+		PadMessage(Messages[i + 1], Length, Tail1);
+		Implementation->Compress2(State0, State1, Tail0, Tail1, TailBlocks);
+
+		StoreDigest(Implementation, State0, Digests + i * DigestLength);
+		StoreDigest(Implementation, State1, Digests + (i + 1) * DigestLength);
+	}
+	if(i < NumberOfMessages) return HashMessage(UserData, Messages[i], Length, Digests + i * DigestLength);
+
+	return true;
+}
+
+#endif
+
+// --- PROVIDERS --- //
+
+static PLC_HashProvider const SHA1Provider_Portable = { HashMessage, 0, (void*)&SHA1_Portable, 20, "SHA-1" };
+static PLC_HashProvider const SHA256Provider_Portable = { HashMessage, 0, (void*)&SHA256_Portable, 32, "SHA-256" };
+#ifdef PLC_X86_SHA
+	static PLC_HashProvider const SHA1Provider_SHANI = { HashMessage, HashMessages, (void*)&SHA1_SHANI, 20, "SHA-1 (SHA-NI)" };
+	static PLC_HashProvider const SHA256Provider_SHANI = { HashMessage, HashMessages, (void*)&SHA256_SHANI, 32, "SHA-256 (SHA-NI)" };
+#endif
+#ifdef PLC_ARM_SHA
+	static PLC_HashProvider const SHA1Provider_ARMv8 = { HashMessage, 0, (void*)&SHA1_ARMv8, 20, "SHA-1 (ARMv8)" };
+	static PLC_HashProvider const SHA256Provider_ARMv8 = { HashMessage, 0, (void*)&SHA256_ARMv8, 32, "SHA-256 (ARMv8)" };
+#endif
+
+PLC_HashProvider const* PLC_GetHashProvider(PLC_HashAlgorithm const Algorithm, bool const Accelerated)
+{
+	if(Algorithm != PLC_Hash_SHA1 && Algorithm != PLC_Hash_SHA256) return 0;
+	bool const SHA1 = Algorithm == PLC_Hash_SHA1;
+
+	if(Accelerated)
+	{
+		#if defined(PLC_X86_SHA)
+			if(HasSHAExtensions()) return SHA1 ? &SHA1Provider_SHANI : &SHA256Provider_SHANI;
+		#elif defined(PLC_ARM_SHA)
+			return SHA1 ? &SHA1Provider_ARMv8 : &SHA256Provider_ARMv8;
+		#endif
+	}
+	return SHA1 ? &SHA1Provider_Portable : &SHA256Provider_Portable;
+}
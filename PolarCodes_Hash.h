@@ -0,0 +1,47 @@
+#ifndef PLC_HASH_H
+#define PLC_HASH_H
+#include <stdint.h>
+#include <stdbool.h>
+
+/*  Hash providers: validation hash and key derivation of PLC_Enroll / PLC_Reproduce (see PLC_SetHashProvider).
+*   Built-in: SHA-1 and SHA-256 (FIPS 180-4). The portable implementation is the reference, the accelerated ones use
+*   the x86 SHA extensions (SHA-NI, selected at runtime) or the ARMv8 crypto extensions (opt-in: define PLC_ARM_SHA and build with
+*   e.g. -march=armv8-a+crypto; checked against an emulation of the intrinsics only, run test_hash.c on the target first).
+*   test_hash.c checks all of them against the FIPS 180 examples.
+*   The SHA-NI implementation hashes two messages interleaved in HashMany (-> multi-buffer, both hash units busy).
+*   Define PLC_NO_SIMD to build the portable implementation only (e.g. for microcontrollers).
+*/
+
+#define PLC_MaxDigestLength 32 // bytes, longest digest a provider may return
+
+/// @brief Hash function used by a context, registered once (PLC_SetHashProvider). Own providers (e.g. a hardware hash unit) fill this struct themselves.
+typedef struct
+{
+	/// @brief Hashes a message.
+	/// @param UserData The provider's UserData.
+	/// @param Digest Output, DigestLength bytes.
+	/// @return True on success.
+	bool (*Hash)(void *const UserData, uint8_t const*const Message, uint32_t const Length, uint8_t *const Digest);
+
+	/// @brief Optional (nullptr -> Hash per message): hashes multiple messages of the same length at once (multi-buffer).
+	/// @param Digests Output, digest i at Digests + i * DigestLength.
+	/// @return True on success.
+	bool (*HashMany)(void *const UserData, uint8_t const*const*const Messages, uint16_t const NumberOfMessages, uint32_t const Length, uint8_t *const Digests);
+
+	void* UserData;
+	uint8_t DigestLength;	// bytes, <= PLC_MaxDigestLength
+	char const* Name;
+} PLC_HashProvider;
+
+typedef enum
+{
+	PLC_Hash_SHA1,		// 20 byte digest, default of every context
+	PLC_Hash_SHA256		// 32 byte digest
+} PLC_HashAlgorithm;
+
+/// @brief Returns a built-in hash provider.
+/// @param Accelerated True -> fastest implementation supported by the CPU (portable if there is none), false -> portable implementation.
+/// @return Provider (static, never freed), nullptr for an unknown algorithm.
+PLC_HashProvider const* PLC_GetHashProvider(PLC_HashAlgorithm const Algorithm, bool const Accelerated);
+
+#endif
@@ -0,0 +1,561 @@
+#include "PolarCodes_Kernels.h"
+#include "BitHelperFunctions.h"
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#if !defined(PLC_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#define PLC_X86_SIMD
+	#include <immintrin.h>
+#endif
+
+// --- SCALAR (reference) --- //
+
+#ifdef PLC_LLR_FLOAT
+typedef float Sum_t; // intermediate of the g-function
+
+/// @brief No saturation for floating point LLRs.
+static BPSK_t Saturate(Sum_t const Value)
+{
+	return Value;
+}
+
+static BPSK_t Magnitude(BPSK_t const Value)
+{
+	return fabsf(Value);
+}
+
+static bool IsNegative(BPSK_t const Value)
+{
+	return signbit(Value); // sign bit, like the vector kernels (-> -0 included)
+}
+#else
+typedef int32_t Sum_t; // intermediate of the g-function
+
+/// @brief Saturates a value to the range of BPSK_t.
+static BPSK_t Saturate(Sum_t const Value)
+{
+	return Value > BPSK_Max ? BPSK_Max : (Value < BPSK_Min ? BPSK_Min : (BPSK_t)Value);
+}
+
+/// @brief Saturating absolute value (-> BPSK_Min maps to BPSK_Max).
+static BPSK_t Magnitude(BPSK_t const Value)
+{
+	return Saturate(Value < 0 ? -(Sum_t)Value : Value);
+}
+
+static bool IsNegative(BPSK_t const Value)
+{
+	return Value < 0;
+}
+#endif
+
+/// @brief Min-sum approximation (often denoted as f)
+static BPSK_t MinSum(BPSK_t const a, BPSK_t const b)
+{
+	BPSK_t const a_abs = Magnitude(a);
+	BPSK_t const b_abs = Magnitude(b);
+
+	BPSK_t const min = a_abs < b_abs ? a_abs : b_abs;
+
+	return IsNegative(a) != IsNegative(b) ? -min : min; // sign: negative if signs of a and b differ
+}
+
+/// @brief g-function in literature
+static BPSK_t g(BPSK_t const a, BPSK_t const b, Decision_t const c)
+{
+	return Saturate(c ? (Sum_t)b - a : (Sum_t)b + a);
+}
+
+static void MinSumArray_Scalar(BPSK_t *const Dst, BPSK_t const*const A, BPSK_t const*const B, uint32_t const Length)
+{
+	for(uint32_t i = 0; i < Length; i++)
+	{
+		Dst[i] = MinSum(A[i], B[i]);
+	}
+}
+
+static void gArray_Scalar(BPSK_t *const Dst, BPSK_t const*const A, BPSK_t const*const B, Decision_t const*const C, uint32_t const CStartIndex, uint32_t const Length)
+{
+	for(uint32_t i = 0; i < Length; i++)
+	{
+		Dst[i] = g(A[i], B[i], GetBitAtIndex(C, CStartIndex + i));
+	}
+}
+
+static void CombineDecisions_Scalar(Decision_t *const Dst, uint32_t const DstStartIndex, Decision_t const*const Src, uint32_t const LeftStartIndex, uint32_t const RightStartIndex, uint32_t const Length)
+{
+	for(uint32_t i = 0; i < Length; i++)
+	{
+		Decision_t const Left = GetBitAtIndex(Src, LeftStartIndex + i);
+		Decision_t const Right = GetBitAtIndex(Src, RightStartIndex + i);
+
+		SetBitAtIndex(Dst, DstStartIndex + i, Left ^ Right);
+		SetBitAtIndex(Dst, DstStartIndex + Length + i, Right);
+	}
+}
+
+static PLC_Kernels const ScalarKernels = { MinSumArray_Scalar, gArray_Scalar, CombineDecisions_Scalar, PLC_KernelLevel_Scalar };
+
+#ifdef PLC_X86_SIMD
+
+/// @brief Combination on whole bytes, used by all vector levels (the byte loop is vectorized by the compiler).
+static void CombineDecisions_Bytes(Decision_t *const Dst, uint32_t const DstStartIndex, Decision_t const*const Src, uint32_t const LeftStartIndex, uint32_t const RightStartIndex, uint32_t const Length)
+{
+	if(((DstStartIndex | LeftStartIndex | RightStartIndex | Length) % 8) != 0)
+	{
+		CombineDecisions_Scalar(Dst, DstStartIndex, Src, LeftStartIndex, RightStartIndex, Length);
+		return;
+	}
+
+	Decision_t *const DstLeft = Dst + DstStartIndex / 8;
+	Decision_t *const DstRight = DstLeft + Length / 8;
+	Decision_t const*const Left = Src + LeftStartIndex / 8;
+	Decision_t const*const Right = Src + RightStartIndex / 8;
+
+	for(uint32_t i = 0; i < Length / 8; i++)
+	{
+		Decision_t const RightByte = Right[i];
+		DstLeft[i] = Left[i] ^ RightByte;
+		DstRight[i] = RightByte;
+	}
+}
+
+#if !defined(PLC_LLR_INT8) && !defined(PLC_LLR_FLOAT)
+
+// --- SSE2 (8 LLRs per instruction) --- //
+
+__attribute__((target("sse2")))
+static void MinSumArray_SSE2(BPSK_t *const Dst, BPSK_t const*const A, BPSK_t const*const B, uint32_t const Length)
+{
+	__m128i const Zero = _mm_setzero_si128();
+	uint32_t i = 0;
+	for(; i + 8 <= Length; i += 8)
+	{
+		__m128i const a = _mm_loadu_si128((__m128i const*)(A + i));
+		__m128i const b = _mm_loadu_si128((__m128i const*)(B + i));
+
+		__m128i const a_abs = _mm_max_epi16(a, _mm_subs_epi16(Zero, a)); // saturating abs
+		__m128i const b_abs = _mm_max_epi16(b, _mm_subs_epi16(Zero, b));
+		__m128i const min = _mm_min_epi16(a_abs, b_abs);
+		__m128i const sign = _mm_srai_epi16(_mm_xor_si128(a, b), 15); // all ones if signs differ
+
+		_mm_storeu_si128((__m128i*)(Dst + i), _mm_sub_epi16(_mm_xor_si128(min, sign), sign));
+	}
+	MinSumArray_Scalar(Dst + i, A + i, B + i, Length - i);
+}
+
+__attribute__((target("sse2")))
+static void gArray_SSE2(BPSK_t *const Dst, BPSK_t const*const A, BPSK_t const*const B, Decision_t const*const C, uint32_t const CStartIndex, uint32_t const Length)
+{
+	uint32_t i = 0;
+	if(CStartIndex % 8 == 0)
+	{
+		__m128i const BitSelect = _mm_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128);
+		for(; i + 8 <= Length; i += 8)
+		{
+			__m128i const a = _mm_loadu_si128((__m128i const*)(A + i));
+			__m128i const b = _mm_loadu_si128((__m128i const*)(B + i));
+			__m128i const Bits = _mm_set1_epi16(C[(CStartIndex + i) / 8]);
+			__m128i const Mask = _mm_cmpeq_epi16(_mm_and_si128(Bits, BitSelect), BitSelect);
+
+			__m128i const Sum = _mm_adds_epi16(b, a);
+			__m128i const Difference = _mm_subs_epi16(b, a);
+			_mm_storeu_si128((__m128i*)(Dst + i), _mm_or_si128(_mm_and_si128(Mask, Difference), _mm_andnot_si128(Mask, Sum)));
+		}
+	}
+	gArray_Scalar(Dst + i, A + i, B + i, C, CStartIndex + i, Length - i);
+}
+
+static PLC_Kernels const SSE2Kernels = { MinSumArray_SSE2, gArray_SSE2, CombineDecisions_Bytes, PLC_KernelLevel_SSE2 };
+
+// --- AVX2 (16 LLRs per instruction) --- //
+
+__attribute__((target("avx2")))
+static void MinSumArray_AVX2(BPSK_t *const Dst, BPSK_t const*const A, BPSK_t const*const B, uint32_t const Length)
+{
+	__m256i const Zero = _mm256_setzero_si256();
+	uint32_t i = 0;
+	for(; i + 16 <= Length; i += 16)
+	{
+		__m256i const a = _mm256_loadu_si256((__m256i const*)(A + i));
+		__m256i const b = _mm256_loadu_si256((__m256i const*)(B + i));
+
+		__m256i const a_abs = _mm256_max_epi16(a, _mm256_subs_epi16(Zero, a)); // saturating abs
+		__m256i const b_abs = _mm256_max_epi16(b, _mm256_subs_epi16(Zero, b));
+		__m256i const min = _mm256_min_epi16(a_abs, b_abs);
+		__m256i const sign = _mm256_srai_epi16(_mm256_xor_si256(a, b), 15); // all ones if signs differ
+
+		_mm256_storeu_si256((__m256i*)(Dst + i), _mm256_sub_epi16(_mm256_xor_si256(min, sign), sign));
+	}
+	MinSumArray_SSE2(Dst + i, A + i, B + i, Length - i);
+}
+
+__attribute__((target("avx2")))
+static void gArray_AVX2(BPSK_t *const Dst, BPSK_t const*const A, BPSK_t const*const B, Decision_t const*const C, uint32_t const CStartIndex, uint32_t const Length)
+{
+	uint32_t i = 0;
+	if(CStartIndex % 8 == 0)
+	{
+		__m256i const BitSelect = _mm256_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192, 16384, (int16_t)0x8000);
+		for(; i + 16 <= Length; i += 16)
+		{
+			Decision_t const*const Bytes = C + (CStartIndex + i) / 8;
+			__m256i const a = _mm256_loadu_si256((__m256i const*)(A + i));
+			__m256i const b = _mm256_loadu_si256((__m256i const*)(B + i));
+			__m256i const Bits = _mm256_set1_epi16((int16_t)(Bytes[0] | (Bytes[1] << 8)));
+			__m256i const Mask = _mm256_cmpeq_epi16(_mm256_and_si256(Bits, BitSelect), BitSelect);
+
+			__m256i const Sum = _mm256_adds_epi16(b, a);
+			__m256i const Difference = _mm256_subs_epi16(b, a);
+			_mm256_storeu_si256((__m256i*)(Dst + i), _mm256_blendv_epi8(Sum, Difference, Mask));
+		}
+	}
+	gArray_SSE2(Dst + i, A + i, B + i, C, CStartIndex + i, Length - i);
+}
+
+static PLC_Kernels const AVX2Kernels = { MinSumArray_AVX2, gArray_AVX2, CombineDecisions_Bytes, PLC_KernelLevel_AVX2 };
+
+// --- AVX-512 (32 LLRs per instruction) --- //
+
+__attribute__((target("avx512f,avx512bw")))
+static void MinSumArray_AVX512(BPSK_t *const Dst, BPSK_t const*const A, BPSK_t const*const B, uint32_t const Length)
+{
+	__m512i const Zero = _mm512_setzero_si512();
+	uint32_t i = 0;
+	for(; i + 32 <= Length; i += 32)
+	{
+		__m512i const a = _mm512_loadu_si512((void const*)(A + i));
+		__m512i const b = _mm512_loadu_si512((void const*)(B + i));
+
+		__m512i const a_abs = _mm512_max_epi16(a, _mm512_subs_epi16(Zero, a)); // saturating abs
+		__m512i const b_abs = _mm512_max_epi16(b, _mm512_subs_epi16(Zero, b));
+		__m512i const min = _mm512_min_epi16(a_abs, b_abs);
+		__mmask32 const SignsDiffer = _mm512_movepi16_mask(_mm512_xor_si512(a, b));
+
+		_mm512_storeu_si512((void*)(Dst + i), _mm512_mask_sub_epi16(min, SignsDiffer, Zero, min));
+	}
+	MinSumArray_AVX2(Dst + i, A + i, B + i, Length - i);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void gArray_AVX512(BPSK_t *const Dst, BPSK_t const*const A, BPSK_t const*const B, Decision_t const*const C, uint32_t const CStartIndex, uint32_t const Length)
+{
+	uint32_t i = 0;
+	if(CStartIndex % 8 == 0)
+	{
+		for(; i + 32 <= Length; i += 32)
+		{
+			Decision_t const*const Bytes = C + (CStartIndex + i) / 8;
+			__m512i const a = _mm512_loadu_si512((void const*)(A + i));
+			__m512i const b = _mm512_loadu_si512((void const*)(B + i));
+			__mmask32 const Mask = (uint32_t)Bytes[0] | ((uint32_t)Bytes[1] << 8) | ((uint32_t)Bytes[2] << 16) | ((uint32_t)Bytes[3] << 24);
+
+			_mm512_storeu_si512((void*)(Dst + i), _mm512_mask_subs_epi16(_mm512_adds_epi16(b, a), Mask, b, a));
+		}
+	}
+	gArray_AVX2(Dst + i, A + i, B + i, C, CStartIndex + i, Length - i);
+}
+
+static PLC_Kernels const AVX512Kernels = { MinSumArray_AVX512, gArray_AVX512, CombineDecisions_Bytes, PLC_KernelLevel_AVX512 };
+
+#elif defined(PLC_LLR_INT8)
+
+#define BitSelect8 0x8040201008040201ll // byte i of a qword selects bit i
+#define SpreadByte 0x0101010101010101ull // multiplier: copies a byte into every byte of a qword
+
+// --- SSE2 (16 LLRs per instruction) --- //
+
+__attribute__((target("sse2")))
+static void MinSumArray_SSE2(BPSK_t *const Dst, BPSK_t const*const A, BPSK_t const*const B, uint32_t const Length)
+{
+	__m128i const Zero = _mm_setzero_si128();
+	uint32_t i = 0;
+	for(; i + 16 <= Length; i += 16)
+	{
+		__m128i const a = _mm_loadu_si128((__m128i const*)(A + i));
+		__m128i const b = _mm_loadu_si128((__m128i const*)(B + i));
+
+		__m128i const a_abs = _mm_min_epu8(a, _mm_subs_epi8(Zero, a)); // saturating abs (as unsigned: min(a, -a), no signed byte min/max in SSE2)
+		__m128i const b_abs = _mm_min_epu8(b, _mm_subs_epi8(Zero, b));
+		__m128i const min = _mm_min_epu8(a_abs, b_abs);
+		__m128i const sign = _mm_cmpgt_epi8(Zero, _mm_xor_si128(a, b)); // all ones if signs differ
+
+		_mm_storeu_si128((__m128i*)(Dst + i), _mm_sub_epi8(_mm_xor_si128(min, sign), sign));
+	}
+	MinSumArray_Scalar(Dst + i, A + i, B + i, Length - i);
+}
+
+__attribute__((target("sse2")))
+static void gArray_SSE2(BPSK_t *const Dst, BPSK_t const*const A, BPSK_t const*const B, Decision_t const*const C, uint32_t const CStartIndex, uint32_t const Length)
+{
+	uint32_t i = 0;
+	if(CStartIndex % 8 == 0)
+	{
+		__m128i const BitSelect = _mm_set1_epi64x(BitSelect8);
+		for(; i + 16 <= Length; i += 16)
+		{
+			Decision_t const*const Bytes = C + (CStartIndex + i) / 8;
+			__m128i const a = _mm_loadu_si128((__m128i const*)(A + i));
+			__m128i const b = _mm_loadu_si128((__m128i const*)(B + i));
+			__m128i const Bits = _mm_set_epi64x((int64_t)(Bytes[1] * SpreadByte), (int64_t)(Bytes[0] * SpreadByte));
+			__m128i const Mask = _mm_cmpeq_epi8(_mm_and_si128(Bits, BitSelect), BitSelect);
+
+			__m128i const Sum = _mm_adds_epi8(b, a);
+			__m128i const Difference = _mm_subs_epi8(b, a);
+			_mm_storeu_si128((__m128i*)(Dst + i), _mm_or_si128(_mm_and_si128(Mask, Difference), _mm_andnot_si128(Mask, Sum)));
+		}
+	}
+	gArray_Scalar(Dst + i, A + i, B + i, C, CStartIndex + i, Length - i);
+}
+
+static PLC_Kernels const SSE2Kernels = { MinSumArray_SSE2, gArray_SSE2, CombineDecisions_Bytes, PLC_KernelLevel_SSE2 };
+
+// --- AVX2 (32 LLRs per instruction) --- //
+
+__attribute__((target("avx2")))
+static void MinSumArray_AVX2(BPSK_t *const Dst, BPSK_t const*const A, BPSK_t const*const B, uint32_t const Length)
+{
+	__m256i const Zero = _mm256_setzero_si256();
+	uint32_t i = 0;
+	for(; i + 32 <= Length; i += 32)
+	{
+		__m256i const a = _mm256_loadu_si256((__m256i const*)(A + i));
+		__m256i const b = _mm256_loadu_si256((__m256i const*)(B + i));
+
+		__m256i const a_abs = _mm256_max_epi8(a, _mm256_subs_epi8(Zero, a)); // saturating abs
+		__m256i const b_abs = _mm256_max_epi8(b, _mm256_subs_epi8(Zero, b));
+		__m256i const min = _mm256_min_epi8(a_abs, b_abs);
+		__m256i const sign = _mm256_cmpgt_epi8(Zero, _mm256_xor_si256(a, b)); // all ones if signs differ
+
+		_mm256_storeu_si256((__m256i*)(Dst + i), _mm256_sub_epi8(_mm256_xor_si256(min, sign), sign));
+	}
+	MinSumArray_SSE2(Dst + i, A + i, B + i, Length - i);
+}
+
+__attribute__((target("avx2")))
+static void gArray_AVX2(BPSK_t *const Dst, BPSK_t const*const A, BPSK_t const*const B, Decision_t const*const C, uint32_t const CStartIndex, uint32_t const Length)
+{
+	uint32_t i = 0;
+	if(CStartIndex % 8 == 0)
+	{
+		__m256i const BitSelect = _mm256_set1_epi64x(BitSelect8);
+		for(; i + 32 <= Length; i += 32)
+		{
+			Decision_t const*const Bytes = C + (CStartIndex + i) / 8;
+			__m256i const a = _mm256_loadu_si256((__m256i const*)(A + i));
+			__m256i const b = _mm256_loadu_si256((__m256i const*)(B + i));
+			__m256i const Bits = _mm256_set_epi64x((int64_t)(Bytes[3] * SpreadByte), (int64_t)(Bytes[2] * SpreadByte),
+												   (int64_t)(Bytes[1] * SpreadByte), (int64_t)(Bytes[0] * SpreadByte));
+			__m256i const Mask = _mm256_cmpeq_epi8(_mm256_and_si256(Bits, BitSelect), BitSelect);
+
+			__m256i const Sum = _mm256_adds_epi8(b, a);
+			__m256i const Difference = _mm256_subs_epi8(b, a);
+			_mm256_storeu_si256((__m256i*)(Dst + i), _mm256_blendv_epi8(Sum, Difference, Mask));
+		}
+	}
+	gArray_SSE2(Dst + i, A + i, B + i, C, CStartIndex + i, Length - i);
+}
+
+static PLC_Kernels const AVX2Kernels = { MinSumArray_AVX2, gArray_AVX2, CombineDecisions_Bytes, PLC_KernelLevel_AVX2 };
+
+// --- AVX-512 (64 LLRs per instruction) --- //
+
+__attribute__((target("avx512f,avx512bw")))
+static void MinSumArray_AVX512(BPSK_t *const Dst, BPSK_t const*const A, BPSK_t const*const B, uint32_t const Length)
+{
+	__m512i const Zero = _mm512_setzero_si512();
+	uint32_t i = 0;
+	for(; i + 64 <= Length; i += 64)
+	{
+		__m512i const a = _mm512_loadu_si512((void const*)(A + i));
+		__m512i const b = _mm512_loadu_si512((void const*)(B + i));
+
+		__m512i const a_abs = _mm512_max_epi8(a, _mm512_subs_epi8(Zero, a)); // saturating abs
+		__m512i const b_abs = _mm512_max_epi8(b, _mm512_subs_epi8(Zero, b));
+		__m512i const min = _mm512_min_epi8(a_abs, b_abs);
+		__mmask64 const SignsDiffer = _mm512_movepi8_mask(_mm512_xor_si512(a, b));
+
+		_mm512_storeu_si512((void*)(Dst + i), _mm512_mask_sub_epi8(min, SignsDiffer, Zero, min));
+	}
+	MinSumArray_AVX2(Dst + i, A + i, B + i, Length - i);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void gArray_AVX512(BPSK_t *const Dst, BPSK_t const*const A, BPSK_t const*const B, Decision_t const*const C, uint32_t const CStartIndex, uint32_t const Length)
+{
+	uint32_t i = 0;
+	if(CStartIndex % 8 == 0)
+	{
+		for(; i + 64 <= Length; i += 64)
+		{
+			__m512i const a = _mm512_loadu_si512((void const*)(A + i));
+			__m512i const b = _mm512_loadu_si512((void const*)(B + i));
+			__mmask64 Mask;
+			memcpy(&Mask, C + (CStartIndex + i) / 8, sizeof(Mask)); // bit i of the mask = bit i of the decisions (little endian)
+
+			_mm512_storeu_si512((void*)(Dst + i), _mm512_mask_subs_epi8(_mm512_adds_epi8(b, a), Mask, b, a));
+		}
+	}
+	gArray_AVX2(Dst + i, A + i, B + i, C, CStartIndex + i, Length - i);
+}
+
+static PLC_Kernels const AVX512Kernels = { MinSumArray_AVX512, gArray_AVX512, CombineDecisions_Bytes, PLC_KernelLevel_AVX512 };
+
+#else // PLC_LLR_FLOAT
+
+// --- SSE2 (4 LLRs per instruction) --- //
+
+__attribute__((target("sse2")))
+static void MinSumArray_SSE2(BPSK_t *const Dst, BPSK_t const*const A, BPSK_t const*const B, uint32_t const Length)
+{
+	__m128 const SignBit = _mm_castsi128_ps(_mm_set1_epi32(INT32_MIN));
+	uint32_t i = 0;
+	for(; i + 4 <= Length; i += 4)
+	{
+		__m128 const a = _mm_loadu_ps(A + i);
+		__m128 const b = _mm_loadu_ps(B + i);
+
+		__m128 const min = _mm_min_ps(_mm_andnot_ps(SignBit, a), _mm_andnot_ps(SignBit, b));
+		__m128 const sign = _mm_and_ps(_mm_xor_ps(a, b), SignBit); // set if signs differ
+
+		_mm_storeu_ps(Dst + i, _mm_or_ps(min, sign));
+	}
+	MinSumArray_Scalar(Dst + i, A + i, B + i, Length - i);
+}
+
+__attribute__((target("sse2")))
+static void gArray_SSE2(BPSK_t *const Dst, BPSK_t const*const A, BPSK_t const*const B, Decision_t const*const C, uint32_t const CStartIndex, uint32_t const Length)
+{
+	uint32_t i = 0;
+	if(CStartIndex % 8 == 0)
+	{
+		__m128i const BitSelectLow = _mm_setr_epi32(1, 2, 4, 8);
+		__m128i const BitSelectHigh = _mm_setr_epi32(16, 32, 64, 128);
+		for(; i + 8 <= Length; i += 8) // one decision byte -> two vectors
+		{
+			__m128i const Bits = _mm_set1_epi32(C[(CStartIndex + i) / 8]);
+			__m128 const MaskLow = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(Bits, BitSelectLow), BitSelectLow));
+			__m128 const MaskHigh = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(Bits, BitSelectHigh), BitSelectHigh));
+
+			__m128 const aLow = _mm_loadu_ps(A + i), aHigh = _mm_loadu_ps(A + i + 4);
+			__m128 const bLow = _mm_loadu_ps(B + i), bHigh = _mm_loadu_ps(B + i + 4);
+			_mm_storeu_ps(Dst + i, _mm_or_ps(_mm_and_ps(MaskLow, _mm_sub_ps(bLow, aLow)), _mm_andnot_ps(MaskLow, _mm_add_ps(bLow, aLow))));
+			_mm_storeu_ps(Dst + i + 4, _mm_or_ps(_mm_and_ps(MaskHigh, _mm_sub_ps(bHigh, aHigh)), _mm_andnot_ps(MaskHigh, _mm_add_ps(bHigh, aHigh))));
+		}
+	}
+	gArray_Scalar(Dst + i, A + i, B + i, C, CStartIndex + i, Length - i);
+}
+
+static PLC_Kernels const SSE2Kernels = { MinSumArray_SSE2, gArray_SSE2, CombineDecisions_Bytes, PLC_KernelLevel_SSE2 };
+
+// --- AVX2 (8 LLRs per instruction) --- //
+
+__attribute__((target("avx2")))
+static void MinSumArray_AVX2(BPSK_t *const Dst, BPSK_t const*const A, BPSK_t const*const B, uint32_t const Length)
+{
+	__m256 const SignBit = _mm256_castsi256_ps(_mm256_set1_epi32(INT32_MIN));
+	uint32_t i = 0;
+	for(; i + 8 <= Length; i += 8)
+	{
+		__m256 const a = _mm256_loadu_ps(A + i);
+		__m256 const b = _mm256_loadu_ps(B + i);
+
+		__m256 const min = _mm256_min_ps(_mm256_andnot_ps(SignBit, a), _mm256_andnot_ps(SignBit, b));
+		__m256 const sign = _mm256_and_ps(_mm256_xor_ps(a, b), SignBit); // set if signs differ
+
+		_mm256_storeu_ps(Dst + i, _mm256_or_ps(min, sign));
+	}
+	MinSumArray_SSE2(Dst + i, A + i, B + i, Length - i);
+}
+
+__attribute__((target("avx2")))
+static void gArray_AVX2(BPSK_t *const Dst, BPSK_t const*const A, BPSK_t const*const B, Decision_t const*const C, uint32_t const CStartIndex, uint32_t const Length)
+{
+	uint32_t i = 0;
+	if(CStartIndex % 8 == 0)
+	{
+		__m256i const BitSelect = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+		for(; i + 8 <= Length; i += 8)
+		{
+			__m256 const a = _mm256_loadu_ps(A + i);
+			__m256 const b = _mm256_loadu_ps(B + i);
+			__m256i const Bits = _mm256_set1_epi32(C[(CStartIndex + i) / 8]);
+			__m256 const Mask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(Bits, BitSelect), BitSelect));
+
+			_mm256_storeu_ps(Dst + i, _mm256_blendv_ps(_mm256_add_ps(b, a), _mm256_sub_ps(b, a), Mask));
+		}
+	}
+	gArray_SSE2(Dst + i, A + i, B + i, C, CStartIndex + i, Length - i);
+}
+
+static PLC_Kernels const AVX2Kernels = { MinSumArray_AVX2, gArray_AVX2, CombineDecisions_Bytes, PLC_KernelLevel_AVX2 };
+
+// --- AVX-512 (16 LLRs per instruction) --- //
+
+__attribute__((target("avx512f,avx512bw")))
+static void MinSumArray_AVX512(BPSK_t *const Dst, BPSK_t const*const A, BPSK_t const*const B, uint32_t const Length)
+{
+	__m512i const SignBit = _mm512_set1_epi32(INT32_MIN);
+	uint32_t i = 0;
+	for(; i + 16 <= Length; i += 16)
+	{
+		__m512 const a = _mm512_loadu_ps(A + i);
+		__m512 const b = _mm512_loadu_ps(B + i);
+
+		__m512 const min = _mm512_min_ps(_mm512_abs_ps(a), _mm512_abs_ps(b));
+		__m512i const sign = _mm512_and_si512(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_castps_si512(b)), SignBit); // set if signs differ
+
+		_mm512_storeu_ps(Dst + i, _mm512_castsi512_ps(_mm512_or_si512(_mm512_castps_si512(min), sign)));
+	}
+	MinSumArray_AVX2(Dst + i, A + i, B + i, Length - i);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void gArray_AVX512(BPSK_t *const Dst, BPSK_t const*const A, BPSK_t const*const B, Decision_t const*const C, uint32_t const CStartIndex, uint32_t const Length)
+{
+	uint32_t i = 0;
+	if(CStartIndex % 8 == 0)
+	{
+		for(; i + 16 <= Length; i += 16)
+		{
+			Decision_t const*const Bytes = C + (CStartIndex + i) / 8;
+			__m512 const a = _mm512_loadu_ps(A + i);
+			__m512 const b = _mm512_loadu_ps(B + i);
+			__mmask16 const Mask = (uint16_t)(Bytes[0] | (Bytes[1] << 8));
+
+			_mm512_storeu_ps(Dst + i, _mm512_mask_sub_ps(_mm512_add_ps(b, a), Mask, b, a));
+		}
+	}
+	gArray_AVX2(Dst + i, A + i, B + i, C, CStartIndex + i, Length - i);
+}
+
+static PLC_Kernels const AVX512Kernels = { MinSumArray_AVX512, gArray_AVX512, CombineDecisions_Bytes, PLC_KernelLevel_AVX512 };
+
+#endif
+
+#endif
+
+PLC_Kernels const* PLC_GetKernels(PLC_KernelLevel const Level)
+{
+	switch(Level)
+	{
+	case PLC_KernelLevel_Scalar: return &ScalarKernels;
+	#ifdef PLC_X86_SIMD
+	case PLC_KernelLevel_SSE2: return __builtin_cpu_supports("sse2") ? &SSE2Kernels : 0;
+	case PLC_KernelLevel_AVX2: return __builtin_cpu_supports("avx2") ? &AVX2Kernels : 0;
+	case PLC_KernelLevel_AVX512: return (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) ? &AVX512Kernels : 0;
+	case PLC_KernelLevel_Best:
+		for(int i = PLC_KernelLevel_AVX512; i > PLC_KernelLevel_Scalar; i--)
+		{
+			PLC_Kernels const*const Kernels = PLC_GetKernels((PLC_KernelLevel)i);
+			if(Kernels != 0) return Kernels;
+		}
+		return &ScalarKernels;
+	#else
+	case PLC_KernelLevel_Best: return &ScalarKernels;
+	#endif
+	default: return 0;
+	}
+}
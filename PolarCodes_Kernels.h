@@ -0,0 +1,56 @@
+#ifndef PLC_KERNELS_H
+#define PLC_KERNELS_H
+#include <stdint.h>
+
+/*  Internal header: f / g / combine kernels of the decoder, operating on contiguous ranges.
+*   The scalar kernels are the reference implementation (saturating arithmetic for integer LLRs).
+*   The vector kernels (SSE2 / AVX2 / AVX-512) are selected at runtime and produce bit-exact results.
+*   Define PLC_NO_SIMD to build the scalar kernels only (e.g. for microcontrollers).
+*
+*   LLR precision is a build option: PLC_LLR_INT8 (saturating, half the memory and twice the lanes of int16), PLC_LLR_FLOAT, default: saturating int16.
+*/
+
+#if defined(PLC_LLR_INT8)
+	#define BPSK_t int8_t
+	#define BPSK_Max INT8_MAX
+	#define BPSK_Min INT8_MIN
+#elif defined(PLC_LLR_FLOAT)
+	#include <float.h>
+	#define BPSK_t float
+	#define BPSK_Max FLT_MAX
+	#define BPSK_Min (-FLT_MAX)
+#else
+	#define BPSK_t int16_t
+	#define BPSK_Max INT16_MAX
+	#define BPSK_Min INT16_MIN
+#endif
+#define Decision_t uint8_t
+
+typedef enum
+{
+	PLC_KernelLevel_Scalar = 0,
+	PLC_KernelLevel_SSE2,
+	PLC_KernelLevel_AVX2,
+	PLC_KernelLevel_AVX512,
+	PLC_KernelLevel_Best // -> highest level supported by the CPU
+} PLC_KernelLevel;
+
+typedef struct
+{
+	/// @brief Min-sum approximation (often denoted as f): Dst[i] = f(A[i], B[i]).
+	void (*f)(BPSK_t *const Dst, BPSK_t const*const A, BPSK_t const*const B, uint32_t const Length);
+
+	/// @brief g-function in literature: Dst[i] = g(A[i], B[i], C[CStartIndex + i]). C is a bit array.
+	void (*g)(BPSK_t *const Dst, BPSK_t const*const A, BPSK_t const*const B, Decision_t const*const C, uint32_t const CStartIndex, uint32_t const Length);
+
+	/// @brief Partial sum combination (bit arrays): Dst[DstStartIndex + i] = Src[LeftStartIndex + i] ^ Src[RightStartIndex + i], Dst[DstStartIndex + Length + i] = Src[RightStartIndex + i].
+	void (*Combine)(Decision_t *const Dst, uint32_t const DstStartIndex, Decision_t const*const Src, uint32_t const LeftStartIndex, uint32_t const RightStartIndex, uint32_t const Length);
+
+	PLC_KernelLevel Level;
+} PLC_Kernels;
+
+/// @brief Returns the kernels of the given level.
+/// @return Kernels, nullptr if the level is not supported by the CPU (or not built).
+PLC_Kernels const* PLC_GetKernels(PLC_KernelLevel const Level);
+
+#endif
@@ -0,0 +1,455 @@
+#define _POSIX_C_SOURCE 200809L
+#include "PolarCodes_Simulation.h"
+#include "BitHelperFunctions.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define SimulationChunkSize 32 // frames taken by a worker at once (= batch size of the hard decision decoder)
+
+#ifdef PLC_LLR_INT8
+	#define SimulationLLRScale 2.0	// quantization steps per nat (as for PLC_Reproduce_MultiReadout)
+#else
+	#define SimulationLLRScale 4.0
+#endif
+
+// --- RANDOM NUMBERS --- //
+
+/// @brief Philox4x32-10 counter based random number generator: 4 random words per (key, counter) pair, no state.
+static void Philox4x32(uint32_t const Key[2], uint32_t const Counter[4], uint32_t Output[4])
+{
+	uint32_t k0 = Key[0], k1 = Key[1];
+	uint32_t c0 = Counter[0], c1 = Counter[1], c2 = Counter[2], c3 = Counter[3];
+
+	for(uint8_t Round = 0; Round < 10; Round++)
+	{
+		uint64_t const p0 = (uint64_t)0xD2511F53u * c0;
+		uint64_t const p1 = (uint64_t)0xCD9E8D57u * c2;
+		c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+		c1 = (uint32_t)p1;
+		c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+		c3 = (uint32_t)p0;
+		k0 += 0x9E3779B9u;
+		k1 += 0xBB67AE85u;
+	}
+
+	Output[0] = c0; Output[1] = c1; Output[2] = c2; Output[3] = c3;
+}
+
+/// @brief Random words of a frame: stream 0 -> information bits, stream 1 -> channel noise.
+typedef struct
+{
+	uint32_t Key[2];
+	uint32_t Counter[4];	// block, frame (low, high), stream
+	uint32_t Buffer[4];
+	uint8_t Available;
+} RandomStream;
+
+static void InitRandomStream(RandomStream *const Stream, uint64_t const Seed, uint64_t const Frame, uint32_t const StreamIndex)
+{
+	Stream->Key[0] = (uint32_t)Seed;
+	Stream->Key[1] = (uint32_t)(Seed >> 32);
+	Stream->Counter[0] = 0;
+	Stream->Counter[1] = (uint32_t)Frame;
+	Stream->Counter[2] = (uint32_t)(Frame >> 32);
+	Stream->Counter[3] = StreamIndex;
+	Stream->Available = 0;
+}
+
+static uint32_t NextRandom(RandomStream *const Stream)
+{
+	if(Stream->Available == 0)
+	{
+		Philox4x32(Stream->Key, Stream->Counter, Stream->Buffer);
+		Stream->Counter[0]++;
+		Stream->Available = 4;
+	}
+	return Stream->Buffer[4 - Stream->Available--];
+}
+
+/// @brief Uniform random number in (0, 1).
+static double NextUniform(RandomStream *const Stream)
+{
+	return (NextRandom(Stream) + 0.5) * (1.0 / 4294967296.0);
+}
+
+// --- CHANNELS --- //
+
+/// @brief Creates the (random) plain text of a frame, frozen bits are 0.
+static void CreatePlainText(uint64_t const Seed, uint64_t const Frame, uint8_t const *const FrozenBitMask, uint32_t const NBytes, uint8_t *const PlainText)
+{
+	RandomStream Stream;
+	InitRandomStream(&Stream, Seed, Frame, 0);
+
+	for(uint32_t i = 0; i < NBytes; i += 4)
+	{
+		uint32_t const Word = NextRandom(&Stream);
+		for(uint32_t j = 0; j < 4 && i + j < NBytes; j++)
+		{
+			PlainText[i + j] = (uint8_t)(Word >> (8 * j)) & FrozenBitMask[i + j];
+		}
+	}
+}
+
+/// @brief Binary symmetric channel: flips every bit of the codeword with the given probability.
+static void ApplyBSC(uint64_t const Seed, uint64_t const Frame, double const CrossoverProbability, uint8_t *const CodeWord, uint32_t const N)
+{
+	RandomStream Stream;
+	InitRandomStream(&Stream, Seed, Frame, 1);
+
+	double const Threshold = CrossoverProbability * 4294967296.0;
+	uint32_t const FlipBelow = Threshold >= 4294967295.0 ? UINT32_MAX : (uint32_t)Threshold;
+	for(uint32_t i = 0; i < N; i++)
+	{
+		if(NextRandom(&Stream) < FlipBelow) SetBitAtIndex(CodeWord, i, !GetBitAtIndex(CodeWord, i));
+	}
+}
+
+/// @brief AWGN channel: BPSK modulated codeword (0 -> +1, 1 -> -1) plus gaussian noise, received as quantized LLRs (2y / sigma^2).
+static void ApplyAWGN(uint64_t const Seed, uint64_t const Frame, double const Sigma, uint8_t const *const CodeWord, uint32_t const N, int16_t *const LLRs)
+{
+	RandomStream Stream;
+	InitRandomStream(&Stream, Seed, Frame, 1);
+
+	double const Scale = SimulationLLRScale * 2 / (Sigma * Sigma);
+	for(uint32_t i = 0; i < N; i += 2)
+	{
+		//Box-Muller -> 2 gaussian samples
+		double const Radius = sqrt(-2 * log(NextUniform(&Stream)));
+		double const Angle = 6.283185307179586 * NextUniform(&Stream);
+		double const Noise[2] = { Radius * cos(Angle), Radius * sin(Angle) };
+
+		for(uint32_t j = 0; j < 2 && i + j < N; j++)
+		{
+			double const y = (GetBitAtIndex(CodeWord, i + j) ? -1.0 : 1.0) + Sigma * Noise[j];
+			double const LLR = round(Scale * y);
+			LLRs[i + j] = LLR > INT16_MAX ? INT16_MAX : (LLR < -INT16_MAX ? -INT16_MAX : (int16_t)LLR);
+		}
+	}
+}
+
+/// @brief Counts the information bit errors between a decoded path and the sent plain text.
+static uint32_t CountBitErrors(uint8_t const *const Path, uint8_t const *const PlainText, uint8_t const *const FrozenBitMask, uint32_t const NBytes)
+{
+	uint32_t Errors = 0;
+	for(uint32_t i = 0; i < NBytes; i++)
+	{
+		Errors += __builtin_popcount((Path[i] ^ PlainText[i]) & FrozenBitMask[i]);
+	}
+	return Errors;
+}
+
+// --- WORKERS --- //
+
+typedef struct SimulationState SimulationState;
+
+typedef struct
+{
+	PLC_Context* Context;	// own clone -> own workspace
+	PLC_Batch* Batch;		// hard decision decoding (BSC)
+	uint8_t* PlainTexts;	// SimulationChunkSize * NBytes
+	uint8_t* CodeWords;		// SimulationChunkSize * NBytes
+	uint8_t* Outputs;		// SimulationChunkSize * NumberOfDecoders * NBytes
+	int16_t* LLRs;			// N, soft decision decoding (AWGN)
+	SimulationState* State;
+	pthread_t Thread;
+	bool Started;
+} SimulationWorker;
+
+struct SimulationState
+{
+	PLC_SimulationSettings const* Settings;
+	double ChannelParameter;
+	double Sigma;				// AWGN noise standard deviation
+	uint32_t N, NBytes;
+	uint8_t NumberOfDecoders;
+
+	pthread_mutex_t Lock;		// guards everything below
+	uint64_t NextFrame;
+	uint64_t Frames;
+	uint64_t FrameErrors;
+	uint64_t BitErrors;
+	bool Failed;
+};
+
+/// @brief Takes the next chunk of frames, unless the point is done.
+/// @return Number of frames taken, 0 -> done.
+static uint32_t TakeFrames(SimulationState *const State, uint64_t *const FirstFrame)
+{
+	pthread_mutex_lock(&State->Lock);
+	uint32_t Count = 0;
+	if(!State->Failed && State->FrameErrors < State->Settings->MinFrameErrors && State->NextFrame < State->Settings->MaxFrames)
+	{
+		uint64_t const Remaining = State->Settings->MaxFrames - State->NextFrame;
+		Count = Remaining < SimulationChunkSize ? (uint32_t)Remaining : SimulationChunkSize;
+		*FirstFrame = State->NextFrame;
+		State->NextFrame += Count;
+	}
+	pthread_mutex_unlock(&State->Lock);
+
+	return Count;
+}
+
+/// @brief Decodes frames with hard input (all frames of the chunk at once).
+/// @return True on success.
+static bool DecodeHard(SimulationWorker *const Worker, uint32_t const Count, uint64_t *const FrameErrors, uint64_t *const BitErrors)
+{
+	SimulationState const*const State = Worker->State;
+	PLC_SimulationSettings const*const Settings = State->Settings;
+	uint32_t const NBytes = State->NBytes;
+	uint8_t const L = State->NumberOfDecoders;
+
+	uint8_t NumberOfPaths[SimulationChunkSize];
+	if(!PLC_SCL_Decode_Batch(Worker->Context, Worker->Batch, Worker->CodeWords, (uint16_t)Count, Settings->FrozenBitMask, Settings->FrozenBitMaskLength,
+							 Worker->Outputs, NumberOfPaths)) return false;
+
+	for(uint32_t f = 0; f < Count; f++)
+	{
+		uint32_t Best = UINT32_MAX;
+		for(uint8_t p = 0; p < NumberOfPaths[f] && Best > 0; p++)
+		{
+			uint32_t const Errors = CountBitErrors(Worker->Outputs + ((size_t)f * L + p) * NBytes, Worker->PlainTexts + (size_t)f * NBytes, Settings->FrozenBitMask, NBytes);
+			if(Errors < Best) Best = Errors;
+		}
+		if(Best == UINT32_MAX) return false; // critical error!!!!!
+
+		*FrameErrors += Best > 0;
+		*BitErrors += Best;
+	}
+	return true;
+}
+
+/// @brief Decodes a single frame with soft input.
+/// @return True on success.
+static bool DecodeSoft(SimulationWorker *const Worker, uint8_t const *const PlainText, uint64_t *const FrameErrors, uint64_t *const BitErrors)
+{
+	SimulationState const*const State = Worker->State;
+	PLC_SimulationSettings const*const Settings = State->Settings;
+
+	uint8_t** List = PLC_SCL_Decode_Soft(Worker->Context, Worker->LLRs, State->N, Settings->FrozenBitMask, Settings->FrozenBitMaskLength);
+	if(List == 0) return false;
+
+	uint32_t Best = UINT32_MAX;
+	for(uint8_t p = 0; p < State->NumberOfDecoders; p++)
+	{
+		if(List[p] == 0) continue;
+
+		uint32_t const Errors = CountBitErrors(List[p], PlainText, Settings->FrozenBitMask, State->NBytes);
+		if(Errors < Best) Best = Errors;
+		free(List[p]);
+	}
+	free(List);
+	if(Best == UINT32_MAX) return false; // critical error!!!!!
+
+	*FrameErrors += Best > 0;
+	*BitErrors += Best;
+	return true;
+}
+
+static void* RunWorker(void* Argument)
+{
+	SimulationWorker *const Worker = Argument;
+	SimulationState *const State = Worker->State;
+	PLC_SimulationSettings const*const Settings = State->Settings;
+	uint32_t const NBytes = State->NBytes;
+
+	uint64_t FirstFrame = 0;
+	uint32_t Count;
+	while((Count = TakeFrames(State, &FirstFrame)) > 0)
+	{
+		uint64_t FrameErrors = 0, BitErrors = 0;
+		bool Success = true;
+
+		for(uint32_t f = 0; f < Count && Success; f++)
+		{
+			uint8_t *const PlainText = Worker->PlainTexts + (size_t)f * NBytes;
+			uint8_t *const CodeWord = Worker->CodeWords + (size_t)f * NBytes;
+
+			CreatePlainText(Settings->Seed, FirstFrame + f, Settings->FrozenBitMask, NBytes, PlainText);
+			memcpy(CodeWord, PlainText, NBytes);
+			Success = PLC_Encode_InPlace(Worker->Context, CodeWord, NBytes);
+
+			if(Success && Settings->Channel == PLC_Channel_AWGN)
+			{
+				ApplyAWGN(Settings->Seed, FirstFrame + f, State->Sigma, CodeWord, State->N, Worker->LLRs);
+				Success = DecodeSoft(Worker, PlainText, &FrameErrors, &BitErrors);
+			}
+			else if(Success)
+			{
+				ApplyBSC(Settings->Seed, FirstFrame + f, State->ChannelParameter, CodeWord, State->N);
+			}
+		}
+		if(Success && Settings->Channel == PLC_Channel_BSC) Success = DecodeHard(Worker, Count, &FrameErrors, &BitErrors);
+
+		pthread_mutex_lock(&State->Lock);
+		State->Failed = State->Failed || !Success;
+		State->Frames += Count;
+		State->FrameErrors += FrameErrors;
+		State->BitErrors += BitErrors;
+		pthread_mutex_unlock(&State->Lock);
+	}
+
+	return 0;
+}
+
+/// @brief Deletes the workers (contexts, buffers) and the worker array.
+static void DeleteWorkers(SimulationWorker* Workers, uint16_t const NumberOfWorkers)
+{
+	if(Workers == 0) return;
+
+	for(uint16_t i = 0; i < NumberOfWorkers; i++)
+	{
+		PLC_DeleteBatch(Workers[i].Batch);
+		PLC_DeleteContext(Workers[i].Context);
+		free(Workers[i].PlainTexts);
+		free(Workers[i].CodeWords);
+		free(Workers[i].Outputs);
+		free(Workers[i].LLRs);
+	}
+	free(Workers);
+}
+
+/// @brief Creates the workers, each with a clone of the given context and its own buffers.
+/// @return Worker array, nullptr on error.
+static SimulationWorker* CreateWorkers(PLC_Context const*const Context, SimulationState *const State, uint16_t const NumberOfWorkers)
+{
+	SimulationWorker* Workers = calloc(NumberOfWorkers, sizeof(SimulationWorker));
+	if(Workers == 0) return 0;
+
+	size_t const FrameBytes = (size_t)SimulationChunkSize * State->NBytes;
+	for(uint16_t i = 0; i < NumberOfWorkers; i++)
+	{
+		SimulationWorker *const Worker = &Workers[i];
+		Worker->State = State;
+		Worker->Context = PLC_CloneContext(Context);
+		Worker->PlainTexts = malloc(FrameBytes);
+		Worker->CodeWords = malloc(FrameBytes);
+
+		bool Success = Worker->Context != 0 && Worker->PlainTexts != 0 && Worker->CodeWords != 0;
+		if(State->Settings->Channel == PLC_Channel_BSC)
+		{
+			Worker->Batch = Success ? PLC_CreateBatch(Worker->Context, SimulationChunkSize) : 0;
+			Worker->Outputs = malloc(FrameBytes * State->NumberOfDecoders);
+			Success = Success && Worker->Batch != 0 && Worker->Outputs != 0;
+		}
+		else
+		{
+			Worker->LLRs = malloc(State->N * sizeof(int16_t));
+			Success = Success && Worker->LLRs != 0;
+		}
+
+		if(!Success)
+		{
+			DeleteWorkers(Workers, i + 1);
+			return 0;
+		}
+	}
+
+	return Workers;
+}
+
+// --- SIMULATION --- //
+
+bool PLC_Simulate(PLC_Context const*const Context, PLC_SimulationSettings const*const Settings, double const ChannelParameter, PLC_SimulationResult *const Result)
+{
+	if(Settings == 0 || Result == 0) return false;
+
+	SimulationState State;
+	memset(&State, 0, sizeof(State));
+	State.Settings = Settings;
+	State.ChannelParameter = ChannelParameter;
+
+	uint32_t K;
+	PLC_GetCodeParameters(Context, &State.N, &K, &State.NumberOfDecoders);
+	State.NBytes = State.N / 8;
+
+	if(Settings->FrozenBitMask == 0 || Settings->FrozenBitMaskLength != State.NBytes) return false;
+	if(Settings->Channel == PLC_Channel_BSC && !(ChannelParameter >= 0 && ChannelParameter <= 1)) return false;
+	if(Settings->Channel == PLC_Channel_AWGN)
+	{
+		//Eb/N0 -> noise of a BPSK symbol, rate K / N
+		double const EbN0 = pow(10, ChannelParameter / 10);
+		State.Sigma = sqrt((double)State.N / (2.0 * K * EbN0));
+		if(!(State.Sigma > 0) || isinf(State.Sigma)) return false;
+	}
+
+	uint16_t NumberOfWorkers = Settings->NumberOfThreads;
+	if(NumberOfWorkers == 0)
+	{
+		long const Processors = sysconf(_SC_NPROCESSORS_ONLN);
+		NumberOfWorkers = Processors > 0 ? (Processors > UINT16_MAX ? UINT16_MAX : (uint16_t)Processors) : 1;
+	}
+
+	if(pthread_mutex_init(&State.Lock, 0) != 0) return false;
+	SimulationWorker* Workers = CreateWorkers(Context, &State, NumberOfWorkers);
+	if(Workers == 0)
+	{
+		pthread_mutex_destroy(&State.Lock);
+		return false;
+	}
+
+	struct timespec Start, End;
+	clock_gettime(CLOCK_MONOTONIC, &Start);
+
+	//worker 0 runs on the calling thread
+	for(uint16_t i = 1; i < NumberOfWorkers; i++)
+	{
+		Workers[i].Started = pthread_create(&Workers[i].Thread, 0, RunWorker, &Workers[i]) == 0;
+	}
+	RunWorker(&Workers[0]);
+
+	for(uint16_t i = 1; i < NumberOfWorkers; i++)
+	{
+		if(Workers[i].Started) pthread_join(Workers[i].Thread, 0);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &End);
+
+	DeleteWorkers(Workers, NumberOfWorkers);
+	pthread_mutex_destroy(&State.Lock);
+	if(State.Failed) return false;
+
+	Result->ChannelParameter = ChannelParameter;
+	Result->Frames = State.Frames;
+	Result->FrameErrors = State.FrameErrors;
+	Result->BitErrors = State.BitErrors;
+	Result->Seconds = (End.tv_sec - Start.tv_sec) + (End.tv_nsec - Start.tv_nsec) * 1e-9;
+	return true;
+}
+
+bool PLC_Simulate_Curve(PLC_Context const*const Context, PLC_SimulationSettings const*const Settings,
+						double const*const ChannelParameters, uint16_t const NumberOfPoints,
+						PLC_SimulationResult *const Results, FILE *const CSV)
+{
+	if(Settings == 0 || (ChannelParameters == 0 && NumberOfPoints > 0)) return false;
+
+	uint32_t N, K;
+	uint8_t L;
+	PLC_GetCodeParameters(Context, &N, &K, &L);
+
+	if(CSV != 0)
+	{
+		fprintf(CSV, "channel,N,K,L,%s,frames,frame_errors,bit_errors,fer,ber,seconds\n", Settings->Channel == PLC_Channel_BSC ? "crossover_probability" : "ebn0_db");
+		fflush(CSV);
+	}
+
+	for(uint16_t i = 0; i < NumberOfPoints; i++)
+	{
+		PLC_SimulationResult Result;
+		if(!PLC_Simulate(Context, Settings, ChannelParameters[i], &Result)) return false;
+		if(Results != 0) Results[i] = Result;
+
+		if(CSV != 0)
+		{
+			double const FER = Result.Frames > 0 ? (double)Result.FrameErrors / Result.Frames : 0;
+			double const BER = Result.Frames > 0 ? (double)Result.BitErrors / ((double)Result.Frames * K) : 0;
+			fprintf(CSV, "%s,%u,%u,%u,%g,%llu,%llu,%llu,%.6e,%.6e,%.3f\n", Settings->Channel == PLC_Channel_BSC ? "bsc" : "awgn", N, K, L, Result.ChannelParameter,
+					(unsigned long long)Result.Frames, (unsigned long long)Result.FrameErrors, (unsigned long long)Result.BitErrors, FER, BER, Result.Seconds);
+			fflush(CSV);
+		}
+	}
+
+	return true;
+}
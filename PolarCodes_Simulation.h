@@ -0,0 +1,64 @@
+#ifndef PLC_SIMULATION_H
+#define PLC_SIMULATION_H
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "PolarCodes_HASCL.h"
+
+/*  Monte Carlo simulation of frame and bit error rates (e.g. to choose N, K, list size and mask for a given SRAM bit flip rate).
+*   Every frame carries random information bits, is encoded, sent over the channel and decoded. A frame counts as error if the sent
+*   plain text is not in the decoder's output list (-> PLC_Reproduce would fail, since the validation hash can't match any candidate).
+*   Random numbers come from a counter based generator (Philox4x32-10) keyed by the seed and indexed by the frame number,
+*   so every frame is the same no matter which thread simulates it. Frames are simulated on worker threads until enough frame errors were collected.
+*   Uses POSIX threads (link with -pthread), compile PolarCodes_Simulation.c alongside PolarCodes_HASCL.c.
+*/
+
+/// @brief Channel model.
+typedef enum
+{
+	PLC_Channel_BSC,	// binary symmetric channel, parameter: crossover (bit flip) probability
+	PLC_Channel_AWGN	// BPSK over additive white gaussian noise, parameter: Eb/N0 in dB, decoded with soft input
+} PLC_Channel;
+
+/// @brief Settings of a simulation, shared by all points of a curve.
+typedef struct
+{
+	PLC_Channel Channel;
+	uint8_t const* FrozenBitMask;
+	uint32_t FrozenBitMaskLength;
+	uint64_t MinFrameErrors;	// a point is done after this many frame errors ...
+	uint64_t MaxFrames;			// ... or this many frames
+	uint16_t NumberOfThreads;	// 0 -> number of online processors
+	uint64_t Seed;
+} PLC_SimulationSettings;
+
+/// @brief Result of a single point.
+typedef struct
+{
+	double ChannelParameter;
+	uint64_t Frames;
+	uint64_t FrameErrors;
+	uint64_t BitErrors;		// information bit errors of the output path closest to the sent plain text
+	double Seconds;
+} PLC_SimulationResult;
+
+/// @brief Simulates a single point of a curve.
+/// @param Context Code parameters and list size, nullptr -> default context (PLC_Init). It is not modified.
+///                Node specializations apply to the AWGN channel only (BSC frames are decoded by PLC_SCL_Decode_Batch), CRC is not used.
+/// @param Settings Simulation settings.
+/// @param ChannelParameter Crossover probability (BSC) or Eb/N0 in dB (AWGN).
+/// @param Result Output.
+/// @return True on success, false on error (invalid parameters, out of memory).
+bool PLC_Simulate(PLC_Context const*const Context, PLC_SimulationSettings const*const Settings, double const ChannelParameter, PLC_SimulationResult *const Result);
+
+/// @brief Simulates all points of a curve, each row is written as CSV as soon as the point is done.
+/// @param ChannelParameters Crossover probabilities (BSC) or Eb/N0 values in dB (AWGN).
+/// @param NumberOfPoints Number of points.
+/// @param Results Output (optional), one result per point.
+/// @param CSV Output file (optional), a header line is written first.
+/// @return True on success, false on error.
+bool PLC_Simulate_Curve(PLC_Context const*const Context, PLC_SimulationSettings const*const Settings,
+                        double const*const ChannelParameters, uint16_t const NumberOfPoints,
+                        PLC_SimulationResult *const Results, FILE *const CSV);
+
+#endif
@@ -0,0 +1,396 @@
+#define _GNU_SOURCE
+#include "PolarCodes_HASCL.h"
+#include "PolarCodes_Construction.h"
+#include "BitHelperFunctions.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#ifdef __linux__
+	#include <sched.h>
+#endif
+#if defined(__GLIBC__) && !defined(BENCHMARK_NO_ALLOC_HOOKS)
+	#include <malloc.h>
+	#define BENCHMARK_ALLOC_HOOKS
+#endif
+
+/*
+	Micro-benchmark of encode, decode and reproduce over a grid of code parameters.
+	Build: gcc -O2 benchmark.c PolarCodes_HASCL.c PolarCodes_Hash.c PolarCodes_Kernels.c PolarCodes_Construction.c BitHelperFunctions.c -lm
+	Usage: benchmark [-o results.json] [-N n] [-K k] [-L l] [-f frames] [-w warmup] [-t seconds] [-p noise] [-c cpu]
+	       -N / -K / -L restrict the grid to one value (N: 64 ... 8192 by default, -N up to 2^20; K: -K 0 -> N / 8 and N / 2), -t limits the measuring time per operation.
+	Allocations and peak heap are counted by wrapping malloc (glibc only, -1 otherwise).
+*/
+
+// --- HEAP ACCOUNTING --- //
+
+static uint64_t Allocations = 0;
+static int64_t HeapInUse = 0;
+static int64_t HeapPeak = 0;
+
+#ifdef BENCHMARK_ALLOC_HOOKS
+extern void* __libc_malloc(size_t Size);
+extern void* __libc_calloc(size_t Count, size_t Size);
+extern void* __libc_realloc(void* Pointer, size_t Size);
+extern void __libc_free(void* Pointer);
+
+static void CountAllocation(void* Pointer)
+{
+	if(Pointer == 0) return;
+
+	Allocations++;
+	HeapInUse += malloc_usable_size(Pointer);
+	if(HeapInUse > HeapPeak) HeapPeak = HeapInUse;
+}
+
+void* malloc(size_t Size)
+{
+	void* Pointer = __libc_malloc(Size);
+	CountAllocation(Pointer);
+	return Pointer;
+}
+
+void* calloc(size_t Count, size_t Size)
+{
+	void* Pointer = __libc_calloc(Count, Size);
+	CountAllocation(Pointer);
+	return Pointer;
+}
+
+void* realloc(void* Pointer, size_t Size)
+{
+	if(Pointer != 0) HeapInUse -= malloc_usable_size(Pointer);
+	void* NewPointer = __libc_realloc(Pointer, Size);
+	if(NewPointer == 0 && Pointer != 0) HeapInUse += malloc_usable_size(Pointer); // failed -> old block is still in use
+	CountAllocation(NewPointer);
+	return NewPointer;
+}
+
+void free(void* Pointer)
+{
+	if(Pointer != 0) HeapInUse -= malloc_usable_size(Pointer);
+	__libc_free(Pointer);
+}
+#endif
+
+// --- HELPER --- //
+
+static uint64_t RandomState = 88172645463325252ull;
+
+/// @brief xorshift64 -> reproducible inputs.
+static uint32_t Random()
+{
+	RandomState ^= RandomState << 13;
+	RandomState ^= RandomState >> 7;
+	RandomState ^= RandomState << 17;
+	return (uint32_t)RandomState;
+}
+
+static uint64_t Now()
+{
+	struct timespec Time;
+	clock_gettime(CLOCK_MONOTONIC, &Time);
+	return (uint64_t)Time.tv_sec * 1000000000ull + Time.tv_nsec;
+}
+
+static int CompareLatencies(void const* a, void const* b)
+{
+	uint64_t const x = *(uint64_t const*)a, y = *(uint64_t const*)b;
+	return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+// --- BENCHMARK --- //
+
+typedef struct
+{
+	uint32_t Frames;
+	uint32_t Warmup;
+	double MaxSeconds;
+	double Noise;
+} BenchmarkSettings;
+
+typedef struct
+{
+	char const* Operation;
+	uint32_t N, K;
+	uint8_t L;
+	uint32_t Frames;
+	double NsPerFrame;
+	uint64_t P50, P99;
+	double BitsPerSecond;		// information bits (K) per second
+	double AllocationsPerCall;
+	int64_t PeakHeap;			// bytes, on top of the heap in use before the call
+	uint32_t Failures;			// calls returning an error / no result
+} BenchmarkResult;
+
+typedef enum { OP_Encode, OP_Decode, OP_Reproduce } Operation;
+
+/// @brief Inputs of one frame.
+typedef struct
+{
+	uint8_t* PlainText;		// frozen bits applied
+	uint8_t* Received;		// codeword with noise (decode)
+	uint8_t* Readout;		// fingerprint with noise (reproduce)
+	uint8_t* HelperData;
+	uint8_t ValidationHash[20];
+} Frame;
+
+#define NumberOfFrameInputs 64 // distinct inputs, used round robin
+
+static uint32_t HelperDataSize(uint32_t const N, uint32_t const K)
+{
+	return (N - K + 7) / 8;
+}
+
+static void CreateFrames(PLC_Context *const Context, uint32_t const N, uint32_t const K, uint8_t const *const Mask, double const Noise, Frame *const Frames)
+{
+	uint32_t const NBytes = N / 8;
+	for(uint32_t f = 0; f < NumberOfFrameInputs; f++)
+	{
+		Frame *const Current = &Frames[f];
+		uint8_t* Fingerprint = malloc(NBytes);
+		Current->PlainText = malloc(NBytes);
+		Current->HelperData = calloc(HelperDataSize(N, K), 1);
+		for(uint32_t i = 0; i < NBytes; i++)
+		{
+			Fingerprint[i] = (uint8_t)Random();
+			Current->PlainText[i] = Fingerprint[i] & Mask[i];
+		}
+
+		//enrollment: codeword bits at the frozen positions are the helper data
+		uint8_t* CodeWord = PLC_Encode_Ctx(Context, Current->PlainText, NBytes);
+		for(uint32_t i = 0, HDIndex = 0; i < N; i++)
+		{
+			if(!GetBitAtIndex(Mask, i)) SetBitAtIndex(Current->HelperData, HDIndex++, GetBitAtIndex(CodeWord, i));
+		}
+		PLC_HashProvider const*const Hash = PLC_GetHashProvider(PLC_Hash_SHA1, true); // default of the context
+		Hash->Hash(Hash->UserData, Current->PlainText, NBytes, Current->ValidationHash);
+
+		//noise: decode -> received codeword, reproduce -> new fingerprint readout
+		Current->Received = malloc(NBytes);
+		memcpy(Current->Received, CodeWord, NBytes);
+		for(uint32_t i = 0; i < N; i++)
+		{
+			if(Random() < Noise * 4294967296.0) SetBitAtIndex(Current->Received, i, !GetBitAtIndex(Current->Received, i));
+		}
+		free(CodeWord);
+
+		//reproduce starts from the fingerprint (not the codeword)
+		Current->Readout = Fingerprint;
+		for(uint32_t i = 0; i < N; i++)
+		{
+			if(Random() < Noise * 4294967296.0) SetBitAtIndex(Current->Readout, i, !GetBitAtIndex(Current->Readout, i));
+		}
+	}
+}
+
+static void DeleteFrames(Frame *const Frames)
+{
+	for(uint32_t f = 0; f < NumberOfFrameInputs; f++)
+	{
+		free(Frames[f].PlainText);
+		free(Frames[f].Received);
+		free(Frames[f].Readout);
+		free(Frames[f].HelperData);
+	}
+}
+
+/// @brief Runs one operation on one frame.
+/// @return True on success.
+static bool RunOperation(PLC_Context *const Context, Operation const Op, uint32_t const N, uint32_t const K, uint8_t const L, uint8_t const *const Mask, Frame const *const Current)
+{
+	uint32_t const NBytes = N / 8;
+	switch(Op)
+	{
+	case OP_Encode:
+		{
+			uint8_t* CodeWord = PLC_Encode_Ctx(Context, Current->PlainText, NBytes);
+			free(CodeWord);
+			return CodeWord != 0;
+		}
+	case OP_Decode:
+		{
+			uint8_t** List = PLC_SCL_Decode_Ctx(Context, Current->Received, NBytes, Mask, NBytes);
+			if(List == 0) return false;
+
+			bool Found = false;
+			for(uint16_t i = 0; i < L; i++)
+			{
+				Found = Found || (List[i] != 0 && memcmp(List[i], Current->PlainText, NBytes) == 0);
+				free(List[i]);
+			}
+			free(List);
+			return Found;
+		}
+	case OP_Reproduce:
+		{
+			uint8_t* Key = PLC_Reproduce_Ctx(Context, Current->Readout, NBytes, Current->HelperData, HelperDataSize(N, K), Mask, NBytes, Current->ValidationHash, 20);
+			free(Key);
+			return Key != 0;
+		}
+	}
+	return false;
+}
+
+static void RunBenchmark(BenchmarkSettings const *const Settings, Operation const Op, uint32_t const N, uint32_t const K, uint8_t const L, BenchmarkResult *const Result)
+{
+	static char const *const Names[] = { "encode", "decode", "reproduce" };
+	uint8_t* Mask = malloc(N / 8);
+	PLC_CreateFrozenBitMask(N, K, PLC_Construction_GA, Settings->Noise > 0 ? Settings->Noise : 0.01, Mask, N / 8);
+
+	PLC_Context* Context = PLC_CreateContext(N, K, L);
+	Frame Frames[NumberOfFrameInputs];
+	CreateFrames(Context, N, K, Mask, Settings->Noise, Frames);
+
+	memset(Result, 0, sizeof(*Result));
+	Result->Operation = Names[Op];
+	Result->N = N;
+	Result->K = K;
+	Result->L = L;
+
+	for(uint32_t i = 0; i < Settings->Warmup; i++) RunOperation(Context, Op, N, K, L, Mask, &Frames[i % NumberOfFrameInputs]);
+
+	uint64_t* Latencies = malloc(Settings->Frames * sizeof(uint64_t));
+	uint64_t const AllocationsBefore = Allocations;
+	int64_t const HeapBefore = HeapInUse;
+	HeapPeak = HeapInUse;
+
+	uint64_t const Start = Now();
+	uint32_t FrameIndex = 0;
+	for(; FrameIndex < Settings->Frames; FrameIndex++)
+	{
+		uint64_t const Begin = Now();
+		if(!RunOperation(Context, Op, N, K, L, Mask, &Frames[FrameIndex % NumberOfFrameInputs])) Result->Failures++;
+		Latencies[FrameIndex] = Now() - Begin;
+
+		if(FrameIndex + 1 >= 10 && (Now() - Start) * 1e-9 > Settings->MaxSeconds) { FrameIndex++; break; } // time budget, at least 10 frames
+	}
+	uint64_t const Total = Now() - Start;
+
+	Result->Frames = FrameIndex;
+	Result->NsPerFrame = (double)Total / FrameIndex;
+	Result->BitsPerSecond = K * 1e9 / Result->NsPerFrame;
+	#ifdef BENCHMARK_ALLOC_HOOKS
+		Result->AllocationsPerCall = (double)(Allocations - AllocationsBefore) / FrameIndex;
+		Result->PeakHeap = HeapPeak - HeapBefore;
+	#else
+		(void)AllocationsBefore; (void)HeapBefore;
+		Result->AllocationsPerCall = -1;
+		Result->PeakHeap = -1;
+	#endif
+
+	qsort(Latencies, FrameIndex, sizeof(uint64_t), CompareLatencies);
+	Result->P50 = Latencies[(FrameIndex - 1) / 2];
+	Result->P99 = Latencies[(uint32_t)((FrameIndex - 1) * 0.99)];
+
+	free(Latencies);
+	DeleteFrames(Frames);
+	PLC_DeleteContext(Context);
+	free(Mask);
+}
+
+static void PrintResult(BenchmarkResult const *const Result)
+{
+	printf("%-9s N=%5u K=%5u L=%3u  %12.0f ns/frame  p50 %10llu  p99 %10llu  %10.3f Mbit/s  %6.1f allocs/call  %9lld B peak  %u/%u failed\n",
+		   Result->Operation, Result->N, Result->K, Result->L, Result->NsPerFrame, (unsigned long long)Result->P50, (unsigned long long)Result->P99,
+		   Result->BitsPerSecond * 1e-6, Result->AllocationsPerCall, (long long)Result->PeakHeap, Result->Failures, Result->Frames);
+}
+
+static void WriteResult(FILE *const File, BenchmarkResult const *const Result, bool const Last)
+{
+	fprintf(File, "    { \"operation\": \"%s\", \"N\": %u, \"K\": %u, \"L\": %u, \"frames\": %u, \"ns_per_frame\": %.1f, \"p50_ns\": %llu, \"p99_ns\": %llu, "
+				  "\"bits_per_second\": %.1f, \"allocations_per_call\": %.2f, \"peak_heap_bytes\": %lld, \"failures\": %u }%s\n",
+			Result->Operation, Result->N, Result->K, Result->L, Result->Frames, Result->NsPerFrame, (unsigned long long)Result->P50, (unsigned long long)Result->P99,
+			Result->BitsPerSecond, Result->AllocationsPerCall, (long long)Result->PeakHeap, Result->Failures, Last ? "" : ",");
+}
+
+static char const Usage[] = "usage: benchmark [-o results.json] [-N n] [-K k] [-L l] [-f frames] [-w warmup] [-t seconds] [-p noise] [-c cpu]\n";
+
+int main(int argc, char** argv)
+{
+	BenchmarkSettings Settings = { 1000, 20, 0.5, 0.02 };
+	char const* OutputPath = 0;
+	int32_t OnlyN = -1, OnlyK = -1, OnlyL = -1, Cpu = 0;
+
+	for(int i = 1; i < argc; i += 2)
+	{
+		if(i + 1 == argc) // lone or trailing flag (e.g. -h)
+		{
+			printf("option %s needs a value\n%s", argv[i], Usage);
+			return -1;
+		}
+
+		if(strcmp(argv[i], "-o") == 0) OutputPath = argv[i + 1];
+		else if(strcmp(argv[i], "-N") == 0) OnlyN = atoi(argv[i + 1]);
+		else if(strcmp(argv[i], "-K") == 0) OnlyK = atoi(argv[i + 1]);
+		else if(strcmp(argv[i], "-L") == 0) OnlyL = atoi(argv[i + 1]);
+		else if(strcmp(argv[i], "-f") == 0) Settings.Frames = (uint32_t)atoi(argv[i + 1]);
+		else if(strcmp(argv[i], "-w") == 0) Settings.Warmup = (uint32_t)atoi(argv[i + 1]);
+		else if(strcmp(argv[i], "-t") == 0) Settings.MaxSeconds = atof(argv[i + 1]);
+		else if(strcmp(argv[i], "-p") == 0) Settings.Noise = atof(argv[i + 1]);
+		else if(strcmp(argv[i], "-c") == 0) Cpu = atoi(argv[i + 1]);
+		else
+		{
+			printf("unknown option %s\n%s", argv[i], Usage);
+			return -1;
+		}
+	}
+	if(Settings.Frames == 0) Settings.Frames = 1;
+	if(OnlyL > UINT8_MAX)
+	{
+		printf("list size has to be in 1 ... %u\n", UINT8_MAX);
+		return -1;
+	}
+
+	//pin to one core -> no migration noise
+	#ifdef __linux__
+		cpu_set_t CpuSet;
+		CPU_ZERO(&CpuSet);
+		CPU_SET(Cpu, &CpuSet);
+		if(sched_setaffinity(0, sizeof(CpuSet), &CpuSet) != 0) printf("warning: could not pin to cpu %d\n", Cpu);
+	#endif
+
+	static uint8_t const ListSizes[] = { 1, 4, 8, 16 };
+	BenchmarkResult Results[512];
+	uint32_t NumberOfResults = 0;
+
+	for(uint32_t N = 64; N <= (OnlyN > 8192 ? (uint32_t)OnlyN : 8192u); N *= 2) // larger N (up to PLC_MaxBlockLength) only on request
+	{
+		if(OnlyN > 0 && (uint32_t)OnlyN != N) continue;
+
+		uint32_t const Ks[2] = { OnlyK > 0 ? (uint32_t)OnlyK : N / 8, N / 2 };
+		for(uint8_t k = 0; k < (OnlyK > 0 ? 1 : 2); k++)
+		{
+			for(uint8_t Op = OP_Encode; Op <= OP_Reproduce; Op++)
+			{
+				for(uint8_t l = 0; l < (OnlyL > 0 ? 1 : sizeof(ListSizes)); l++) // -L: any list size, not only the ones of the grid
+				{
+					if(Op == OP_Encode && l > 0) break; // list size does not matter
+
+					BenchmarkResult *const Result = &Results[NumberOfResults++];
+					RunBenchmark(&Settings, (Operation)Op, N, Ks[k], OnlyL > 0 ? (uint8_t)OnlyL : ListSizes[l], Result);
+					PrintResult(Result);
+				}
+			}
+		}
+	}
+
+	if(OutputPath != 0)
+	{
+		FILE* File = fopen(OutputPath, "w");
+		if(File == 0)
+		{
+			printf("could not write %s\n", OutputPath);
+			return -1;
+		}
+
+		fprintf(File, "{\n  \"settings\": { \"frames\": %u, \"warmup\": %u, \"max_seconds\": %.3f, \"noise\": %.4f, \"cpu\": %d },\n  \"results\": [\n",
+				Settings.Frames, Settings.Warmup, Settings.MaxSeconds, Settings.Noise, Cpu);
+		for(uint32_t i = 0; i < NumberOfResults; i++) WriteResult(File, &Results[i], i + 1 == NumberOfResults);
+		fprintf(File, "  ]\n}\n");
+		fclose(File);
+	}
+
+	return 0;
+}
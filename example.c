@@ -4,7 +4,7 @@
 #include <stdio.h>
 
 /*
-	If you want to build/run this example, uncomment define "IgnoreTomCrypt" in PolarCodes_HASCL.c
+	Build: gcc -O2 example.c PolarCodes_HASCL.c PolarCodes_Hash.c PolarCodes_Kernels.c BitHelperFunctions.c -lm
 */
 
 int main()
@@ -42,10 +42,11 @@ int main()
 	printf("\n");
 
 	// --- encode --- //
-	uint8_t* EncodedWord = PLC_Encode(Plain, PlainLength);
+	uint8_t EncodedWord[N / 8];
+	bool const Encoded = PLC_Encode_Into(0, Plain, PlainLength, EncodedWord, sizeof(EncodedWord));
 	free(Plain); Plain = 0;
 
-	if(EncodedWord == 0) return -1; //encoding failed
+	if(!Encoded) return -1; //encoding failed
 
 	printf("Encoded word: ");
 	for(uint32_t i = 0; i < NBytes; i++)
@@ -57,25 +58,28 @@ int main()
 	//apply noise, etc...
 
 	// --- decode --- //
-	uint8_t** DecodedList = PLC_SCL_Decode(EncodedWord, NBytes, FrozenBitMask, FrozenBitMaskLength);
-	free(EncodedWord); EncodedWord = 0;
+	uint8_t DecodedList[NumberOfDecoders * N / 8]; //path i starts at i * NBytes
+	PLC_PathMetric PathMetrics[NumberOfDecoders];
+	uint8_t const NumberOfPaths = PLC_SCL_Decode_Into(0, EncodedWord, NBytes, FrozenBitMask, FrozenBitMaskLength, DecodedList, sizeof(DecodedList), PathMetrics);
 
-	if(DecodedList == 0) return -2; //decoding failed
+	if(NumberOfPaths == 0) return -2; //decoding failed
 
 	//decide on correct decoder output (via CRC or hash, ...)
 	printf("Decoder outputs:\n");
-	for(uint8_t i = 0; i < NumberOfDecoders; i++)
+	for(uint8_t i = 0; i < NumberOfPaths; i++)
 	{
 		//TODO
 
-		printf("%u: ", i);
+		printf("%u (metric %g): ", i, (double)PathMetrics[i]);
 		for(uint32_t j = 0; j < NBytes; j++)
 		{
-			printf("0x%02X ", DecodedList[i][j]);
+			printf("0x%02X ", DecodedList[i * NBytes + j]);
 		}
 		printf("\n");
 	}
 
-	//extract message bits
-	//TODO
+	//extract message bits (PLC_SCL_Decode_InfoBits returns only those)
+	uint8_t Messages[NumberOfDecoders * ((K + 7) / 8)];
+	if(PLC_SCL_Decode_InfoBits(0, EncodedWord, NBytes, FrozenBitMask, FrozenBitMaskLength, Messages, sizeof(Messages), 0) == 0) return -3;
+	printf("Information bits of best path: 0x%02X\n", Messages[0]);
 }
\ No newline at end of file
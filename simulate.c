@@ -0,0 +1,116 @@
+#include "PolarCodes_HASCL.h"
+#include "PolarCodes_Simulation.h"
+#include "PolarCodes_Construction.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/*
+	Frame / bit error rate curves.
+	Build: gcc -O2 simulate.c PolarCodes_Simulation.c PolarCodes_Construction.c PolarCodes_HASCL.c PolarCodes_Hash.c PolarCodes_Kernels.c BitHelperFunctions.c -lm -pthread
+	Usage: simulate [-c bsc|awgn] [-N n] [-K k] [-L l] [-from x] [-to x] [-points n] [-e min. frame errors] [-m max. frames] [-t threads] [-s seed] [-mask ga|bhattacharyya|nr] [-o curve.csv]
+	       BSC: crossover probabilities from ... to, spaced logarithmically. AWGN: Eb/N0 (dB) from ... to, spaced linearly.
+	The frozen bit mask is constructed for the worst point of the curve (AWGN -> crossover probability of hard decisions). Output: CSV (stdout if no file is given).
+*/
+
+static char const Usage[] = "usage: simulate [-c bsc|awgn] [-N n] [-K k] [-L l] [-from x] [-to x] [-points n] [-e min. frame errors] [-m max. frames] [-t threads] [-s seed] [-mask ga|bhattacharyya|nr] [-o curve.csv]\n";
+
+int main(int argc, char** argv)
+{
+	PLC_SimulationSettings Settings = { PLC_Channel_BSC, 0, 0, 100, 10000000, 0, 1 };
+	uint32_t N = 1024, K = 128, L = 8, NumberOfPoints = 8;
+	double From = 0.20, To = 0.05;
+	bool RangeGiven = false;
+	char const* OutputPath = 0;
+	PLC_ConstructionMethod Construction = PLC_Construction_GA;
+
+	for(int i = 1; i < argc; i += 2)
+	{
+		if(i + 1 == argc) // lone or trailing flag (e.g. -h)
+		{
+			printf("option %s needs a value\n%s", argv[i], Usage);
+			return -1;
+		}
+
+		if(strcmp(argv[i], "-c") == 0) Settings.Channel = strcmp(argv[i + 1], "awgn") == 0 ? PLC_Channel_AWGN : PLC_Channel_BSC;
+		else if(strcmp(argv[i], "-N") == 0) N = (uint32_t)atoi(argv[i + 1]);
+		else if(strcmp(argv[i], "-K") == 0) K = (uint32_t)atoi(argv[i + 1]);
+		else if(strcmp(argv[i], "-L") == 0) L = (uint32_t)atoi(argv[i + 1]);
+		else if(strcmp(argv[i], "-from") == 0) { From = atof(argv[i + 1]); RangeGiven = true; }
+		else if(strcmp(argv[i], "-to") == 0) { To = atof(argv[i + 1]); RangeGiven = true; }
+		else if(strcmp(argv[i], "-points") == 0) NumberOfPoints = (uint32_t)atoi(argv[i + 1]);
+		else if(strcmp(argv[i], "-e") == 0) Settings.MinFrameErrors = strtoull(argv[i + 1], 0, 10);
+		else if(strcmp(argv[i], "-m") == 0) Settings.MaxFrames = strtoull(argv[i + 1], 0, 10);
+		else if(strcmp(argv[i], "-t") == 0) Settings.NumberOfThreads = (uint16_t)atoi(argv[i + 1]);
+		else if(strcmp(argv[i], "-s") == 0) Settings.Seed = strtoull(argv[i + 1], 0, 10);
+		else if(strcmp(argv[i], "-o") == 0) OutputPath = argv[i + 1];
+		else if(strcmp(argv[i], "-mask") == 0)
+		{
+			Construction = strcmp(argv[i + 1], "nr") == 0 ? PLC_Construction_5GNR :
+						   (strcmp(argv[i + 1], "bhattacharyya") == 0 ? PLC_Construction_Bhattacharyya : PLC_Construction_GA);
+		}
+		else
+		{
+			printf("unknown option %s\n%s", argv[i], Usage);
+			return -1;
+		}
+	}
+	if(Settings.Channel == PLC_Channel_AWGN && !RangeGiven)
+	{
+		From = 1.0;
+		To = 4.5;
+	}
+	if(NumberOfPoints == 0 || NumberOfPoints > 1000) NumberOfPoints = 1;
+
+	PLC_Context* Context = PLC_CreateContext(N, K, (uint8_t)L);
+	if(Context == 0)
+	{
+		printf("invalid code parameters\n");
+		return -1;
+	}
+
+	double* Points = malloc(NumberOfPoints * sizeof(double));
+	uint8_t* Mask = malloc(N / 8);
+	if(Points == 0 || Mask == 0)
+	{
+		printf("out of memory\n");
+		free(Mask);
+		free(Points);
+		PLC_DeleteContext(Context);
+		return -1;
+	}
+
+	for(uint32_t i = 0; i < NumberOfPoints; i++)
+	{
+		double const t = NumberOfPoints > 1 ? (double)i / (NumberOfPoints - 1) : 0;
+		Points[i] = Settings.Channel == PLC_Channel_BSC ? From * pow(To / From, t) : From + (To - From) * t;
+	}
+
+	//mask for the worst point: BSC -> crossover probability, AWGN -> hard decisions flip with Q(sqrt(2 R Eb/N0))
+	double const Worst = Settings.Channel == PLC_Channel_BSC ? fmax(From, To) : fmin(From, To);
+	double const CrossoverProbability = Settings.Channel == PLC_Channel_BSC ? Worst : 0.5 * erfc(sqrt((double)K / N * pow(10, Worst / 10)));
+	if(!PLC_CreateFrozenBitMask(N, K, Construction, CrossoverProbability, Mask, N / 8))
+	{
+		printf("could not construct the frozen bit mask\n");
+		return -1;
+	}
+	Settings.FrozenBitMask = Mask;
+	Settings.FrozenBitMaskLength = N / 8;
+
+	FILE* CSV = OutputPath != 0 ? fopen(OutputPath, "w") : stdout;
+	if(CSV == 0)
+	{
+		printf("could not write %s\n", OutputPath);
+		return -1;
+	}
+
+	bool const Success = PLC_Simulate_Curve(Context, &Settings, Points, (uint16_t)NumberOfPoints, 0, CSV);
+	if(!Success) printf("simulation failed\n");
+
+	if(CSV != stdout) fclose(CSV);
+	free(Mask);
+	free(Points);
+	PLC_DeleteContext(Context);
+	return Success ? 0 : -1;
+}
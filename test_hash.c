@@ -0,0 +1,156 @@
+#include "PolarCodes_Hash.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+	Known-answer test of the built-in hash providers (FIPS 180-4 / NIST example messages) and comparison of the accelerated
+	providers (Hash and HashMany) against the portable reference over message lengths 0 ... 300.
+	Build: gcc -O2 test_hash.c PolarCodes_Hash.c
+	       add -DPLC_NO_SIMD to check the portable build; on ARMv8, add -DPLC_ARM_SHA -march=armv8-a+crypto to check that implementation (opt-in).
+	Returns 0 if all digests match.
+*/
+
+#define MaxMessageLength 300
+#define MaxMessages 5 // HashMany: odd and even numbers of messages (-> pairs + single rest)
+
+typedef struct
+{
+	char const* Name;
+	char const* Message;	// nullptr -> one million times 'a'
+	char const* SHA1;
+	char const* SHA256;
+} KnownAnswer;
+
+static KnownAnswer const KnownAnswers[] =
+{
+	{ "empty", "",
+	  "da39a3ee5e6b4b0d3255bfef95601890afd80709",
+	  "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" },
+	{ "abc", "abc",
+	  "a9993e364706816aba3e25717850c26c9cd0d89d",
+	  "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" },
+	{ "448 bit", "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+	  "84983e441c3bd26ebaae4aa1f95129e5e54670f1",
+	  "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1" },
+	{ "million a", 0,
+	  "34aa973cd4c4daa4f61eeb2bdbad27316534016f",
+	  "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0" }
+};
+
+// --- HELPER --- //
+
+static uint64_t RandomState = 88172645463325252ull;
+
+/// @brief xorshift64 -> reproducible inputs.
+static uint32_t Random()
+{
+	RandomState ^= RandomState << 13;
+	RandomState ^= RandomState >> 7;
+	RandomState ^= RandomState << 17;
+	return (uint32_t)RandomState;
+}
+
+static void ToHex(uint8_t const*const Digest, uint8_t const Length, char *const Hex)
+{
+	for(uint8_t i = 0; i < Length; i++) sprintf(Hex + 2 * i, "%02x", Digest[i]);
+}
+
+// --- TESTS --- //
+
+/// @brief Hashes the example messages with the provider and compares the digests with the known answers.
+/// @return Number of wrong digests.
+static uint32_t CheckKnownAnswers(PLC_HashProvider const*const Provider, PLC_HashAlgorithm const Algorithm, uint8_t const*const MillionA)
+{
+	uint32_t Errors = 0;
+	for(size_t i = 0; i < sizeof(KnownAnswers) / sizeof(KnownAnswers[0]); i++)
+	{
+		KnownAnswer const*const Answer = &KnownAnswers[i];
+		uint8_t const*const Message = Answer->Message != 0 ? (uint8_t const*)Answer->Message : MillionA;
+		uint32_t const Length = Answer->Message != 0 ? (uint32_t)strlen(Answer->Message) : 1000000;
+		char const*const Expected = Algorithm == PLC_Hash_SHA1 ? Answer->SHA1 : Answer->SHA256;
+
+		uint8_t Digest[PLC_MaxDigestLength];
+		char Hex[2 * PLC_MaxDigestLength + 1] = "";
+		if(Provider->Hash(Provider->UserData, Message, Length, Digest)) ToHex(Digest, Provider->DigestLength, Hex);
+		if(strcmp(Hex, Expected) != 0)
+		{
+			printf("  %s, %s: %s, expected %s\n", Provider->Name, Answer->Name, Hex, Expected);
+			Errors++;
+		}
+	}
+	return Errors;
+}
+
+/// @brief Compares Hash and HashMany of the provider with the reference on random messages of every length 0 ... MaxMessageLength.
+/// @return Number of wrong digests.
+static uint32_t CompareWithReference(PLC_HashProvider const*const Provider, PLC_HashProvider const*const Reference)
+{
+	static uint8_t Data[MaxMessages][MaxMessageLength];
+	uint8_t const* Messages[MaxMessages];
+	uint8_t Digests[MaxMessages * PLC_MaxDigestLength], Expected[MaxMessages * PLC_MaxDigestLength];
+	uint8_t const DigestLength = Provider->DigestLength;
+	uint32_t Errors = 0;
+
+	for(uint32_t Length = 0; Length <= MaxMessageLength; Length++)
+	{
+		for(uint8_t m = 0; m < MaxMessages; m++)
+		{
+			for(uint32_t i = 0; i < MaxMessageLength; i++) Data[m][i] = (uint8_t)Random();
+			Messages[m] = Data[m];
+			if(!Reference->Hash(Reference->UserData, Data[m], Length, Expected + m * DigestLength)) Errors++;
+		}
+
+		if(!Provider->Hash(Provider->UserData, Data[0], Length, Digests) || memcmp(Digests, Expected, DigestLength) != 0)
+		{
+			printf("  %s: Hash differs from %s, length %u\n", Provider->Name, Reference->Name, Length);
+			Errors++;
+		}
+
+		if(Provider->HashMany == 0) continue;
+		for(uint16_t NumberOfMessages = 1; NumberOfMessages <= MaxMessages; NumberOfMessages++)
+		{
+			memset(Digests, 0, sizeof(Digests));
+			if(!Provider->HashMany(Provider->UserData, Messages, NumberOfMessages, Length, Digests) || memcmp(Digests, Expected, NumberOfMessages * DigestLength) != 0)
+			{
+				printf("  %s: HashMany differs from %s, length %u, %u messages\n", Provider->Name, Reference->Name, Length, NumberOfMessages);
+				Errors++;
+			}
+		}
+	}
+	return Errors;
+}
+
+int main()
+{
+	static PLC_HashAlgorithm const Algorithms[] = { PLC_Hash_SHA1, PLC_Hash_SHA256 };
+	uint8_t *const MillionA = malloc(1000000);
+	if(MillionA == 0) return 1;
+	memset(MillionA, 'a', 1000000);
+	uint32_t Errors = 0;
+
+	for(size_t a = 0; a < sizeof(Algorithms) / sizeof(Algorithms[0]); a++)
+	{
+		PLC_HashProvider const*const Portable = PLC_GetHashProvider(Algorithms[a], false);
+		PLC_HashProvider const*const Accelerated = PLC_GetHashProvider(Algorithms[a], true);
+
+		uint32_t const PortableErrors = CheckKnownAnswers(Portable, Algorithms[a], MillionA);
+		printf("%-18s known answers: %u errors\n", Portable->Name, PortableErrors);
+		Errors += PortableErrors;
+
+		if(Accelerated == Portable)
+		{
+			printf("%-18s no accelerated implementation on this CPU / build\n", Portable->Name);
+			continue;
+		}
+
+		uint32_t AcceleratedErrors = CheckKnownAnswers(Accelerated, Algorithms[a], MillionA);
+		AcceleratedErrors += CompareWithReference(Accelerated, Portable);
+		printf("%-18s known answers + lengths 0 ... %u%s: %u errors\n", Accelerated->Name, MaxMessageLength, Accelerated->HashMany != 0 ? " (Hash, HashMany)" : "", AcceleratedErrors);
+		Errors += AcceleratedErrors;
+	}
+
+	free(MillionA);
+	printf(Errors > 0 ? "FAILED\n" : "all digests correct\n");
+	return Errors > 0 ? 1 : 0;
+}
@@ -0,0 +1,211 @@
+extern "C"
+{
+	#include "PolarCodes_HASCL.h"
+}
+#include "PolarCodes_HASCL.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+
+/*
+	Compares polar::SclDecoder (PolarCodes_HASCL.hpp) against PLC_SCL_Decode_Ctx / PLC_SCL_Decode_Soft on random words and masks:
+	hard and soft input, frozen bit mask at runtime and at compile time, N = 8 ... 1024, several list sizes.
+	Build: gcc -O2 -c PolarCodes_HASCL.c PolarCodes_Hash.c PolarCodes_Kernels.c BitHelperFunctions.c
+	       g++ -std=c++17 -O2 test_hpp.cpp PolarCodes_HASCL.o PolarCodes_Hash.o PolarCodes_Kernels.o BitHelperFunctions.o -lm -o test_hpp
+	       add -DPLC_LLR_INT8 or -DPLC_LLR_FLOAT to both lines to compare the other LLR precisions.
+	Usage: test_hpp [rounds per configuration]
+	Returns 0 if all lists match.
+*/
+
+#if defined(PLC_LLR_INT8)
+	using LLR_t = std::int8_t;
+#elif defined(PLC_LLR_FLOAT)
+	using LLR_t = float;
+#else
+	using LLR_t = std::int16_t;
+#endif
+
+// --- HELPER --- //
+
+static std::uint64_t RandomState = 88172645463325252ull;
+
+/// @brief xorshift64 -> reproducible inputs.
+static std::uint32_t Random()
+{
+	RandomState ^= RandomState << 13;
+	RandomState ^= RandomState >> 7;
+	RandomState ^= RandomState << 17;
+	return (std::uint32_t)RandomState;
+}
+
+/// @brief Random soft input, every eighth value an edge case (saturation, zero).
+static std::int16_t RandomLLR()
+{
+	static std::int16_t const EdgeCases[] = { INT16_MIN, -128, -127, -1, 0, 1, 127, 128, INT16_MAX };
+	if(Random() % 8 == 0) return EdgeCases[Random() % (sizeof(EdgeCases) / sizeof(EdgeCases[0]))];
+	return (std::int16_t)((std::int32_t)(Random() % 401) - 200);
+}
+
+/// @brief Soft input as converted by PLC_SCL_Decode_Soft.
+static LLR_t ConvertLLR(std::int16_t const LLR)
+{
+	#ifdef PLC_LLR_INT8
+		return (LLR_t)(LLR > INT8_MAX ? INT8_MAX : (LLR < INT8_MIN ? INT8_MIN : LLR));
+	#else
+		return (LLR_t)LLR;
+	#endif
+}
+
+/// @brief Compares the list of the C decoder (nullptr -> unused entry) with the list of the template (entries behind Count zeroed).
+template<std::size_t NBytes, std::size_t L>
+static bool CompareLists(std::uint8_t** CList, std::array<std::array<std::uint8_t, NBytes>, L> const& Output, std::size_t const Count)
+{
+	bool Equal = CList != 0;
+	for(std::size_t p = 0; p < L && CList != 0; p++)
+	{
+		if(CList[p] == 0) Equal = Equal && p >= Count;
+		else Equal = Equal && p < Count && std::memcmp(CList[p], Output[p].data(), NBytes) == 0;
+		std::free(CList[p]);
+	}
+	std::free(CList);
+	return Equal;
+}
+
+// --- MASKS --- //
+
+/// @brief Random mask with K information bits.
+template<std::size_t N>
+static std::array<std::uint8_t, N / 8> RandomMask(std::size_t const K)
+{
+	std::array<std::uint8_t, N / 8> Mask{};
+	for(std::size_t Set = 0; Set < K;)
+	{
+		std::size_t const i = Random() % N;
+		if(polar::detail::GetBit(Mask.data(), i)) continue;
+		polar::detail::SetBit(Mask.data(), i, 1);
+		Set++;
+	}
+	return Mask;
+}
+
+/// @brief Compile-time mask: information bits at the indices with at least Weight ones (Reed-Muller like).
+template<std::size_t N, std::size_t Weight>
+struct WeightMask
+{
+	static constexpr std::array<std::uint8_t, N / 8> Create()
+	{
+		std::array<std::uint8_t, N / 8> Mask{};
+		for(std::size_t i = 0; i < N; i++)
+		{
+			std::size_t Ones = 0;
+			for(std::size_t Bits = i; Bits != 0; Bits /= 2) Ones += Bits % 2;
+			if(Ones >= Weight) Mask[i / 8] = (std::uint8_t)(Mask[i / 8] | (1u << (i % 8)));
+		}
+		return Mask;
+	}
+
+	static constexpr std::array<std::uint8_t, N / 8> Value = Create();
+};
+
+// --- COMPARISON --- //
+
+/// @brief Decodes random words with both decoders, frozen bit mask at runtime (random K and mask per round) or at compile time (Mask).
+/// @return Number of mismatching lists.
+template<std::size_t N, std::size_t L, typename Mask = void>
+static std::uint32_t CompareDecoders(std::uint32_t const Rounds)
+{
+	using Decoder = polar::SclDecoder<N, L, LLR_t, Mask>;
+	constexpr std::size_t NBytes = N / 8;
+	auto const Template = std::make_unique<Decoder>();
+	auto const Output = std::make_unique<typename Decoder::List>();
+	std::uint32_t Mismatches = 0;
+
+	for(std::uint32_t Round = 0; Round < Rounds; Round++)
+	{
+		typename Decoder::Word FrozenBitMask;
+		std::size_t K;
+		if constexpr(std::is_void<Mask>::value)
+		{
+			K = 1 + Random() % N;
+			FrozenBitMask = RandomMask<N>(K);
+		}
+		else
+		{
+			FrozenBitMask = Mask::Value;
+			K = 0;
+			for(std::size_t i = 0; i < N; i++) K += polar::detail::GetBit(FrozenBitMask.data(), i);
+		}
+
+		PLC_Context *const Context = PLC_CreateContext(N, (std::uint32_t)K, L);
+		if(Context == 0)
+		{
+			std::printf("  could not create a context: N %zu, K %zu, L %zu\n", N, K, L);
+			return Mismatches + 1;
+		}
+
+		// hard input
+		typename Decoder::Word Input;
+		for(std::size_t i = 0; i < NBytes; i++) Input[i] = (std::uint8_t)Random();
+		std::size_t Count;
+		if constexpr(std::is_void<Mask>::value) Count = Template->Decode(Input, FrozenBitMask, *Output);
+		else Count = Template->Decode(Input, *Output);
+		if(!CompareLists(PLC_SCL_Decode_Ctx(Context, Input.data(), NBytes, FrozenBitMask.data(), NBytes), *Output, Count))
+		{
+			std::printf("  hard input mismatch: N %zu, K %zu, L %zu%s\n", N, K, L, std::is_void<Mask>::value ? "" : ", compile-time mask");
+			Mismatches++;
+		}
+
+		// soft input
+		std::array<std::int16_t, N> LLRs;
+		typename Decoder::LLRs Converted;
+		for(std::size_t i = 0; i < N; i++)
+		{
+			LLRs[i] = RandomLLR();
+			Converted[i] = ConvertLLR(LLRs[i]);
+		}
+		if constexpr(std::is_void<Mask>::value) Count = Template->DecodeSoft(Converted, FrozenBitMask, *Output);
+		else Count = Template->DecodeSoft(Converted, *Output);
+		if(!CompareLists(PLC_SCL_Decode_Soft(Context, LLRs.data(), N, FrozenBitMask.data(), NBytes), *Output, Count))
+		{
+			std::printf("  soft input mismatch: N %zu, K %zu, L %zu%s\n", N, K, L, std::is_void<Mask>::value ? "" : ", compile-time mask");
+			Mismatches++;
+		}
+
+		PLC_DeleteContext(Context);
+	}
+	return Mismatches;
+}
+
+/// @brief Runtime masks for N = 8 ... 1024 with list size L.
+template<std::size_t L, std::size_t... Exponents>
+static std::uint32_t CompareAllLengths(std::uint32_t const Rounds, std::index_sequence<Exponents...>)
+{
+	return (CompareDecoders<(std::size_t)8 << Exponents, L>(Rounds) + ...);
+}
+
+int main(int argc, char** argv)
+{
+	std::uint32_t const Rounds = argc > 1 ? (std::uint32_t)std::atoi(argv[1]) : 20;
+	std::uint32_t Mismatches = 0;
+
+	using Lengths = std::make_index_sequence<8>; // N = 8 ... 1024
+	Mismatches += CompareAllLengths<1>(Rounds, Lengths());
+	Mismatches += CompareAllLengths<2>(Rounds, Lengths());
+	Mismatches += CompareAllLengths<3>(Rounds, Lengths());
+	Mismatches += CompareAllLengths<4>(Rounds, Lengths());
+	Mismatches += CompareAllLengths<8>(Rounds, Lengths());
+	Mismatches += CompareAllLengths<16>(Rounds, Lengths());
+	Mismatches += CompareAllLengths<70>(Rounds, Lengths());
+	std::printf("runtime masks: %u mismatches\n", Mismatches);
+
+	std::uint32_t const Before = Mismatches;
+	Mismatches += CompareDecoders<64, 4, WeightMask<64, 3>>(Rounds);
+	Mismatches += CompareDecoders<64, 32, WeightMask<64, 2>>(Rounds);
+	Mismatches += CompareDecoders<256, 8, WeightMask<256, 4>>(Rounds);
+	Mismatches += CompareDecoders<1024, 4, WeightMask<1024, 6>>(Rounds);
+	std::printf("compile-time masks: %u mismatches\n", Mismatches - Before);
+
+	std::printf(Mismatches > 0 ? "FAILED\n" : "template decoder bit-exact to PLC_SCL_Decode\n");
+	return Mismatches > 0 ? 1 : 0;
+}
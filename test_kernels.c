@@ -0,0 +1,158 @@
+#include "PolarCodes_Kernels.h"
+#include "BitHelperFunctions.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/*
+	Compares the vector kernels (every level PLC_GetKernels supports on this CPU) against the scalar reference, bit by bit.
+	Build: gcc -O2 test_kernels.c PolarCodes_Kernels.c BitHelperFunctions.c -lm
+	       add -DPLC_LLR_INT8 or -DPLC_LLR_FLOAT to check the kernels of the other LLR precisions (as for the library).
+	Usage: test_kernels [rounds]
+	Returns 0 if all kernels match.
+*/
+
+#define MaxLength 300			// LLRs per call
+#define DecisionBytes 128		// bit arrays of the g / combine calls
+
+// --- HELPER --- //
+
+static uint64_t RandomState = 88172645463325252ull;
+
+/// @brief xorshift64 -> reproducible inputs.
+static uint32_t Random()
+{
+	RandomState ^= RandomState << 13;
+	RandomState ^= RandomState >> 7;
+	RandomState ^= RandomState << 17;
+	return (uint32_t)RandomState;
+}
+
+#ifdef PLC_LLR_FLOAT
+/// @brief Random LLR, every fourth one an edge case (signed zeros -> sign bit handling, largest magnitudes -> overflow to infinity, denormals).
+static BPSK_t RandomLLR()
+{
+	static BPSK_t const EdgeCases[] = { BPSK_Min, -1.0f, -1e-40f, -0.0f, 0.0f, 1e-40f, 1.0f, BPSK_Max };
+	if(Random() % 4 == 0) return EdgeCases[Random() % (sizeof(EdgeCases) / sizeof(EdgeCases[0]))];
+	return (int32_t)Random() / 65536.0f;
+}
+#else
+/// @brief Random LLR, every fourth one an edge case of the saturating arithmetic.
+static BPSK_t RandomLLR()
+{
+	static BPSK_t const EdgeCases[] = { BPSK_Min, BPSK_Min + 1, -1, 0, 1, BPSK_Max - 1, BPSK_Max };
+	if(Random() % 4 == 0) return EdgeCases[Random() % (sizeof(EdgeCases) / sizeof(EdgeCases[0]))];
+	return (BPSK_t)Random();
+}
+#endif
+
+static void FillLLRs(BPSK_t *const LLRs, uint32_t const Length)
+{
+	for(uint32_t i = 0; i < Length; i++) LLRs[i] = RandomLLR();
+}
+
+static void FillBytes(uint8_t *const Bytes, uint32_t const Length)
+{
+	for(uint32_t i = 0; i < Length; i++) Bytes[i] = (uint8_t)Random();
+}
+
+/// @brief Length of a call: mostly short (remainder loops), sometimes up to MaxLength.
+static uint32_t RandomLength()
+{
+	return Random() % 2 ? Random() % 33 : Random() % (MaxLength + 1);
+}
+
+/// @brief Start index (or length) of a bit range, rounded down to whole bytes if aligned (-> vector path).
+static uint32_t RandomBitOffset(uint32_t const Max, bool const Aligned)
+{
+	uint32_t const Offset = Random() % (Max + 1);
+	return Aligned ? Offset & ~7u : Offset;
+}
+
+// --- COMPARISON --- //
+
+/// @brief Runs random calls of all three kernels of the given level and the scalar kernels on the same inputs.
+/// @return Number of mismatching calls.
+static uint32_t CompareKernels(PLC_Kernels const*const Kernels, PLC_Kernels const*const Reference, uint32_t const Rounds)
+{
+	// +1 element -> inputs and outputs start at unaligned addresses as well
+	static BPSK_t A[MaxLength + 1], B[MaxLength + 1], Dst[MaxLength + 1], Expected[MaxLength + 1];
+	static uint8_t C[DecisionBytes], DecisionDst[DecisionBytes], DecisionExpected[DecisionBytes];
+	uint32_t Mismatches = 0;
+
+	for(uint32_t Round = 0; Round < Rounds; Round++)
+	{
+		uint32_t const Length = RandomLength();
+		uint32_t const Offset = Random() % 2;
+		FillLLRs(A, MaxLength + 1);
+		FillLLRs(B, MaxLength + 1);
+
+		// f
+		FillLLRs(Dst, MaxLength + 1);
+		memcpy(Expected, Dst, sizeof(Dst));
+		Kernels->f(Dst + Offset, A + Offset, B + Offset, Length);
+		Reference->f(Expected + Offset, A + Offset, B + Offset, Length);
+		if(memcmp(Dst, Expected, sizeof(Dst)) != 0)
+		{
+			printf("  f mismatch: length %u, offset %u\n", Length, Offset);
+			Mismatches++;
+		}
+
+		// g
+		uint32_t const CStartIndex = RandomBitOffset(DecisionBytes * 8 - MaxLength, Random() % 2);
+		FillBytes(C, DecisionBytes);
+		FillLLRs(Dst, MaxLength + 1);
+		memcpy(Expected, Dst, sizeof(Dst));
+		Kernels->g(Dst + Offset, A + Offset, B + Offset, C, CStartIndex, Length);
+		Reference->g(Expected + Offset, A + Offset, B + Offset, C, CStartIndex, Length);
+		if(memcmp(Dst, Expected, sizeof(Dst)) != 0)
+		{
+			printf("  g mismatch: length %u, offset %u, decision offset %u\n", Length, Offset, CStartIndex);
+			Mismatches++;
+		}
+
+		// combine (source and destination ranges don't overlap, like in the decoder), half of the calls on whole bytes
+		bool const Aligned = Random() % 2;
+		uint32_t const CombineLength = RandomBitOffset(RandomLength() % (DecisionBytes * 2), Aligned);
+		uint32_t const LeftStartIndex = RandomBitOffset(DecisionBytes * 4 - CombineLength, Aligned);
+		uint32_t const RightStartIndex = RandomBitOffset(DecisionBytes * 4 - CombineLength, Aligned);
+		uint32_t const DstStartIndex = RandomBitOffset(DecisionBytes * 8 - 2 * CombineLength, Aligned);
+		FillBytes(C, DecisionBytes);
+		FillBytes(DecisionDst, DecisionBytes);
+		memcpy(DecisionExpected, DecisionDst, DecisionBytes);
+		Kernels->Combine(DecisionDst, DstStartIndex, C, LeftStartIndex, RightStartIndex, CombineLength);
+		Reference->Combine(DecisionExpected, DstStartIndex, C, LeftStartIndex, RightStartIndex, CombineLength);
+		if(memcmp(DecisionDst, DecisionExpected, DecisionBytes) != 0)
+		{
+			printf("  combine mismatch: length %u, offsets %u / %u -> %u\n", CombineLength, LeftStartIndex, RightStartIndex, DstStartIndex);
+			Mismatches++;
+		}
+	}
+	return Mismatches;
+}
+
+int main(int argc, char** argv)
+{
+	static char const *const Names[] = { "scalar", "sse2", "avx2", "avx512" };
+	uint32_t const Rounds = argc > 1 ? (uint32_t)atoi(argv[1]) : 100000;
+	PLC_Kernels const*const Reference = PLC_GetKernels(PLC_KernelLevel_Scalar);
+	bool Failed = false;
+
+	for(int Level = PLC_KernelLevel_SSE2; Level < PLC_KernelLevel_Best; Level++)
+	{
+		PLC_Kernels const*const Kernels = PLC_GetKernels((PLC_KernelLevel)Level);
+		if(Kernels == 0)
+		{
+			printf("%-7s not supported (or not built)\n", Names[Level]);
+			continue;
+		}
+
+		uint32_t const Mismatches = CompareKernels(Kernels, Reference, Rounds);
+		printf("%-7s %u rounds, %u mismatches\n", Names[Level], Rounds, Mismatches);
+		Failed = Failed || Mismatches > 0;
+	}
+
+	printf(Failed ? "FAILED\n" : "all kernels bit-exact to the scalar reference\n");
+	return Failed ? 1 : 0;
+}